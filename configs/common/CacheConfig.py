@@ -45,6 +45,8 @@ from common.Caches import *
 
 import m5
 from m5.objects import *
+from m5.params import isNullPointer
+from m5.proxy import isproxy
 
 from gem5.isas import ISA
 
@@ -72,9 +74,37 @@ def _get_cache_opts(level, options):
     if hasattr(options, prefetcher_attr):
         opts["prefetcher"] = _get_hwp(getattr(options, prefetcher_attr))
 
+    if getattr(options, "caches_warm_only", False):
+        opts["warm_only"] = True
+
     return opts
 
 
+def _use_packed_tags(cache):
+    """
+    Replace the default tags of a cache with PackedSetAssoc when its
+    configuration has a compile-time specialised version. The decisions
+    made are the same, so this only changes the simulation speed.
+    """
+    if type(cache.tags) is not BaseSetAssoc:
+        return
+    if type(cache.tags.indexing_policy) is not SetAssociative:
+        return
+    if not isNullPointer(cache.partitioning_manager):
+        return
+    if int(cache.assoc) not in (2, 4, 8, 16):
+        return
+
+    rp = cache.replacement_policy
+    if type(rp) is TreePLRURP:
+        if not isproxy(rp.num_leaves) and int(rp.num_leaves) != int(cache.assoc):
+            return
+    elif type(rp) is not LRURP:
+        return
+
+    cache.tags = PackedSetAssoc()
+
+
 def config_cache(options, system):
     if options.external_memory_system and (options.caches or options.l2cache):
         print("External caches and internal caches are exclusive options.\n")
@@ -134,6 +164,7 @@ def config_cache(options, system):
         system.l2 = l2_cache_class(
             clk_domain=system.cpu_clk_domain, **_get_cache_opts("l2", options)
         )
+        _use_packed_tags(system.l2)
 
         system.tol2bus = L2XBar(clk_domain=system.cpu_clk_domain)
         system.l2.cpu_side = system.tol2bus.mem_side_ports
@@ -146,6 +177,8 @@ def config_cache(options, system):
         if options.caches:
             icache = icache_class(**_get_cache_opts("l1i", options))
             dcache = dcache_class(**_get_cache_opts("l1d", options))
+            _use_packed_tags(icache)
+            _use_packed_tags(dcache)
 
             # If we are using ISA.X86 or ISA.RISCV, we set walker caches.
             if ObjectList.cpu_list.get_isa(options.cpu_type) in [
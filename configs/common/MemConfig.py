@@ -144,6 +144,12 @@ def config_mem(options, system):
     opt_dram_powerdown = getattr(options, "enable_dram_powerdown", None)
     opt_mem_channels_intlv = getattr(options, "mem_channels_intlv", 128)
     opt_xor_low_bit = getattr(options, "xor_low_bit", 0)
+    opt_mem_channel_threads = getattr(options, "mem_channel_threads", False)
+
+    if getattr(options, "sparse_mem", False):
+        system.sparse_backstore = True
+    if getattr(options, "mem_checkpoint_format", None):
+        system.memory_checkpoint_format = options.mem_checkpoint_format
 
     if opt_mem_type == "HMC_2500_1x32":
         HMChost = HMC.config_hmc_host_ctrl(options, system)
@@ -272,6 +278,7 @@ def config_mem(options, system):
         mem_ctrls[i].nvm = nvm_intfs[i]
 
     # Connect the controller to the xbar port
+    mem_bridges = []
     for i in range(len(mem_ctrls)):
         if opt_mem_type == "HMC_2500_1x32":
             # Connect the controllers to the membus
@@ -279,8 +286,21 @@ def config_mem(options, system):
             # Set memory device size. There is an independent controller
             # for each vault. All vaults are same size.
             mem_ctrls[i].dram.device_size = options.hmc_dev_vault_size
+        elif opt_mem_channel_threads:
+            # Run each controller, and its interfaces which inherit its
+            # event queue, on an event queue of its own, reached from the
+            # membus through a bridge adding at least the quantum
+            bridge = m5.objects.ThreadBridge(
+                eventq_index=i + 1, delay=f"{options.mem_channel_latency}t"
+            )
+            mem_ctrls[i].eventq_index = i + 1
+            bridge.in_port = xbar.mem_side_ports
+            mem_ctrls[i].port = bridge.out_port
+            mem_bridges.append(bridge)
         else:
             # Connect the controllers to the membus
             mem_ctrls[i].port = xbar.mem_side_ports
 
     subsystem.mem_ctrls = mem_ctrls
+    if mem_bridges:
+        subsystem.mem_bridges = mem_bridges
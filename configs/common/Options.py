@@ -158,6 +158,32 @@ def addNoISAOptions(parser):
         default="512MB",
         help="Specify the physical memory size (single memory)",
     )
+    parser.add_argument(
+        "--sparse-mem",
+        action="store_true",
+        help="Populate the host memory backing the simulated memory "
+        "lazily, with transparent huge pages",
+    )
+    parser.add_argument(
+        "--mem-checkpoint-format",
+        choices=["gzip", "pages", "compressed_pages"],
+        default=None,
+        help="Format of the simulated memory in checkpoints",
+    )
+    parser.add_argument(
+        "--mem-channel-threads",
+        action="store_true",
+        help="Simulate each memory controller on its own event queue, "
+        "and host thread, behind a ThreadBridge",
+    )
+    parser.add_argument(
+        "--mem-channel-latency",
+        type=int,
+        default=1000,
+        help="Latency in ticks added by the ThreadBridge of each memory "
+        "controller in each direction with --mem-channel-threads, which "
+        "is also the simulation quantum",
+    )
     parser.add_argument(
         "--enable-dram-powerdown",
         action="store_true",
@@ -185,6 +211,12 @@ def addNoISAOptions(parser):
     )
     parser.add_argument("--caches", action="store_true")
     parser.add_argument("--l2cache", action="store_true")
+    parser.add_argument(
+        "--caches-warm-only",
+        action="store_true",
+        help="Service atomic cache accesses (e.g. while fast-forwarding "
+        "with AtomicSimpleCPU) through the warm-only path",
+    )
     parser.add_argument("--num-dirs", type=int, default=1)
     parser.add_argument("--num-l2caches", type=int, default=1)
     parser.add_argument("--num-l3caches", type=int, default=1)
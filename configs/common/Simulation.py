@@ -681,6 +681,9 @@ def run(options, root, testsys, cpu_class):
     checkpoint_dir = None
     if options.checkpoint_restore:
         cpt_starttick, checkpoint_dir = findCptDir(options, cptdir, testsys)
+    if getattr(options, "mem_channel_threads", False):
+        # The memory controllers run on event queues of their own
+        root.sim_quantum = options.mem_channel_latency
     root.apply_config(options.param)
     m5.instantiate(checkpoint_dir)
 
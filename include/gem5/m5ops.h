@@ -59,6 +59,7 @@ uint64_t m5_read_file(void *buffer, uint64_t len, uint64_t offset);
 uint64_t m5_write_file(void *buffer, uint64_t len, uint64_t offset,
                        const char *filename);
 void m5_debug_break(void);
+void m5_dump_trace(void);
 void m5_switch_cpu(void);
 void m5_dist_toggle_sync(void);
 void m5_add_symbol(uint64_t addr, const char *symbol);
@@ -111,6 +111,16 @@ class MMU : public BaseMMU
         UserMode = 0x10
     };
 
+    /**
+     * Tagged addresses are purified, and the alignment of accesses with
+     * an alignment mask checked, before the page table is looked up.
+     */
+    bool
+    seTranslatesDirectly(Addr vaddr, Request::Flags flags) const override
+    {
+        return bits(vaddr, 63, 48) == 0 && !(flags & AlignmentMask);
+    }
+
     enum ArmTranslationType
     {
         NormalTran = 0,
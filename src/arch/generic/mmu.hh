@@ -148,6 +148,18 @@ class BaseMMU : public SimObject
     virtual TranslationGenPtr translateFunctional(Addr start, Addr size,
             ThreadContext *tc, BaseMMU::Mode mode, Request::Flags flags) = 0;
 
+    /**
+     * Whether the functional translations of a SE mode process at a
+     * virtual address may be looked up in its page table directly,
+     * without going through the MMU. MMUs which transform or check the
+     * addresses before looking them up must override this.
+     */
+    virtual bool
+    seTranslatesDirectly(Addr vaddr, Request::Flags flags) const
+    {
+        return true;
+    }
+
     virtual Fault
     finalizePhysical(const RequestPtr &req, ThreadContext *tc,
                      Mode mode) const;
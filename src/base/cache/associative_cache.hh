@@ -67,6 +67,12 @@ class AssociativeCache : public Named
     /** The entries */
     std::vector<Entry> entries;
 
+    /**
+     * Buffer for the possible entries of the address being looked up,
+     * reused so that lookups do not allocate.
+     */
+    mutable std::vector<ReplaceableEntry *> candidates;
+
   private:
 
     void
@@ -74,6 +80,7 @@ class AssociativeCache : public Named
     {
         fatal_if((_num_entries % _assoc) != 0, "The number of entries of an "
                  "AssociativeCache<> must be a multiple of its associativity");
+        candidates.reserve(_assoc);
         for (auto entry_idx = 0; entry_idx < _num_entries; entry_idx++) {
             Entry *entry = &entries[entry_idx];
             indexingPolicy->setEntry(entry, entry_idx);
@@ -198,7 +205,7 @@ class AssociativeCache : public Named
     {
         auto tag = getTag(addr);
 
-        auto candidates = indexingPolicy->getPossibleEntries(addr);
+        indexingPolicy->getPossibleEntries(addr, candidates);
 
         for (auto candidate : candidates) {
             Entry *entry = static_cast<Entry*>(candidate);
@@ -218,7 +225,7 @@ class AssociativeCache : public Named
     virtual Entry*
     findVictim(const Addr addr)
     {
-        auto candidates = indexingPolicy->getPossibleEntries(addr);
+        indexingPolicy->getPossibleEntries(addr, candidates);
 
         auto victim = static_cast<Entry*>(replPolicy->getVictim(candidates));
 
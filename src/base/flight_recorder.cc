@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the debug message flight recorder.
+ */
+
+#include "base/flight_recorder.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+std::atomic<uint64_t> nextRecorderId{0};
+
+/** A buffer of the host thread, and the recorder it belongs to. */
+struct CachedBuffer
+{
+    uint64_t recorderId = ~uint64_t(0);
+    void *buffer = nullptr;
+};
+
+/**
+ * The buffers the host thread used last, the most recent first, so that
+ * a thread recording to a few recorders does not search for its buffer
+ * on each message.
+ */
+thread_local CachedBuffer cachedBuffers[4];
+
+constexpr size_t maxChunkSize = 64 * 1024;
+
+size_t
+roundUp8(size_t size)
+{
+    return (size + 7) & ~size_t(7);
+}
+
+} // anonymous namespace
+
+FlightRecorder::FlightRecorder(size_t size)
+    : id(nextRecorderId++),
+      chunkSize(std::clamp<size_t>(size / 4, 256, maxChunkSize) &
+                ~size_t(7)),
+      numChunks(std::max<size_t>(2, size / chunkSize))
+{
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    // The ids are not reused, so the entries of the other threads will
+    // never match again.
+    for (auto &cached : cachedBuffers) {
+        if (cached.recorderId == id)
+            cached = CachedBuffer();
+    }
+}
+
+FlightRecorder::Buffer &
+FlightRecorder::localBuffer()
+{
+    if (GEM5_LIKELY(cachedBuffers[0].recorderId == id))
+        return *static_cast<Buffer *>(cachedBuffers[0].buffer);
+    return findLocalBuffer();
+}
+
+FlightRecorder::Buffer &
+FlightRecorder::findLocalBuffer()
+{
+    constexpr size_t num_cached = std::size(cachedBuffers);
+    auto *first = std::begin(cachedBuffers);
+
+    auto *cached = std::find_if(first + 1, std::end(cachedBuffers),
+        [this](const CachedBuffer &c) { return c.recorderId == id; });
+    if (cached != std::end(cachedBuffers)) {
+        std::rotate(first, cached, cached + 1);
+        return *static_cast<Buffer *>(first->buffer);
+    }
+
+    Buffer *buf = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        const auto self = std::this_thread::get_id();
+        for (auto &other : buffers) {
+            if (other->owner == self)
+                buf = other.get();
+        }
+        if (!buf) {
+            auto new_buf = std::make_unique<Buffer>();
+            new_buf->owner = self;
+            new_buf->data.resize(chunkSize * numChunks);
+            new_buf->used.resize(numChunks, 0);
+            buf = new_buf.get();
+            buffers.push_back(std::move(new_buf));
+        }
+    }
+
+    // Make room at the front, dropping the least recently used entry
+    std::rotate(first, first + num_cached - 1, first + num_cached);
+    *first = CachedBuffer{id, buf};
+    return *buf;
+}
+
+void
+FlightRecorder::store(Buffer &buf, Tick when, const std::string &name,
+                      const std::string &flag, const char *fmt,
+                      FormatFunc format, const std::string &packed)
+{
+    const uint16_t name_len = std::min<size_t>(name.size(), UINT16_MAX);
+    const uint16_t flag_len = std::min<size_t>(flag.size(), UINT16_MAX);
+    const size_t size = roundUp8(sizeof(Header) + name_len + flag_len +
+                                 packed.size());
+
+    std::lock_guard<UncontendedMutex> lock(buf.mutex);
+
+    if (size > chunkSize) {
+        ++buf.dropped;
+        return;
+    }
+
+    // Move to the chunk holding the oldest messages if this one is full
+    if (buf.used[buf.current] + size > chunkSize) {
+        buf.current = (buf.current + 1) % numChunks;
+        buf.used[buf.current] = 0;
+    }
+
+    char *dest = &buf.data[buf.current * chunkSize + buf.used[buf.current]];
+    buf.used[buf.current] += size;
+
+    const Header header{when, fmt, format, uint32_t(size), name_len,
+                        flag_len};
+    std::memcpy(dest, &header, sizeof(header));
+    dest += sizeof(header);
+    std::memcpy(dest, name.data(), name_len);
+    dest += name_len;
+    std::memcpy(dest, flag.data(), flag_len);
+    dest += flag_len;
+    std::memcpy(dest, packed.data(), packed.size());
+}
+
+void
+FlightRecorder::dump(const DumpFunc &func)
+{
+    std::vector<Buffer *> to_dump;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto &buf : buffers)
+            to_dump.push_back(buf.get());
+    }
+
+    struct Message
+    {
+        Tick when;
+        std::string name;
+        std::string flag;
+        std::string text;
+    };
+    std::vector<Message> messages;
+    std::ostringstream text;
+
+    for (Buffer *buf : to_dump) {
+        messages.clear();
+        {
+            // The owner may reuse the chunks as soon as the lock is
+            // released, so format the messages before.
+            std::lock_guard<UncontendedMutex> lock(buf->mutex);
+
+            // The chunk after the current one holds the oldest messages
+            for (size_t i = 1; i <= numChunks; i++) {
+                const size_t chunk = (buf->current + i) % numChunks;
+                const char *start = &buf->data[chunk * chunkSize];
+                for (size_t offset = 0; offset < buf->used[chunk]; ) {
+                    Header header;
+                    std::memcpy(&header, start + offset, sizeof(header));
+                    const char *name = start + offset + sizeof(header);
+                    const char *flag = name + header.nameLen;
+                    const char *args = flag + header.flagLen;
+
+                    text.str("");
+                    header.format(text, header.fmt, args);
+                    messages.push_back({header.when,
+                                        std::string(name, header.nameLen),
+                                        std::string(flag, header.flagLen),
+                                        text.str()});
+
+                    offset += header.size;
+                }
+                buf->used[chunk] = 0;
+            }
+            buf->current = 0;
+            buf->dropped = 0;
+        }
+
+        for (const auto &message : messages)
+            func(message.when, message.name, message.flag, message.text);
+    }
+}
+
+uint64_t
+FlightRecorder::droppedMessages() const
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    uint64_t dropped = 0;
+    for (auto &buf : buffers) {
+        std::lock_guard<UncontendedMutex> buf_lock(buf->mutex);
+        dropped += buf->dropped;
+    }
+    return dropped;
+}
+
+} // namespace trace
+} // namespace gem5
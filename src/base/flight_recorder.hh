@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * In-memory buffer keeping the last debug messages without formatting
+ * them, used by the flight recorder debug logger.
+ */
+
+#ifndef __BASE_FLIGHT_RECORDER_HH__
+#define __BASE_FLIGHT_RECORDER_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/types.hh"
+#include "base/uncontended_mutex.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * Keeps the last debug messages in memory. A message is stored as its
+ * tick, name, flag, a pointer to its format string and a binary copy of
+ * its arguments, and is only formatted when the messages are dumped, so
+ * recording one costs a few copies instead of a cprintf.
+ *
+ * Each host thread records to its own buffer, made of fixed size chunks
+ * used in turn. When all the chunks are full, the one holding the oldest
+ * messages is reused, so the buffer always holds the most recent
+ * messages. Each buffer has a lock, which its thread takes to record a
+ * message and dump() takes to read it. It is only contended while the
+ * messages are dumped, and costs an atomic operation otherwise.
+ *
+ * Arithmetic, enum and pointer arguments are copied as they are, and
+ * strings by value. Arguments of other types are printed to a string when
+ * recorded. The format string is not copied when there are arguments, so
+ * it must be a string literal, as is the case for the DPRINTF macros.
+ */
+class FlightRecorder
+{
+  public:
+    /** Called for each message by dump(), the oldest one first. */
+    using DumpFunc = std::function<void(Tick when, const std::string &name,
+                                        const std::string &flag,
+                                        const std::string &message)>;
+
+    /**
+     * @param size Size of the buffer of each host thread, in bytes.
+     */
+    FlightRecorder(size_t size);
+    ~FlightRecorder();
+
+    /** Records a message, overwriting the oldest ones if needed. */
+    template <typename ...Args>
+    void
+    record(Tick when, const std::string &name, const std::string &flag,
+           const char *fmt, const Args &...args)
+    {
+        Buffer &buf = localBuffer();
+        std::string &packed = buf.scratch;
+        packed.clear();
+        if constexpr (sizeof...(Args) == 0) {
+            // A format without arguments may well be a temporary string
+            packString(packed, fmt, std::strlen(fmt));
+            store(buf, when, name, flag, nullptr, &formatNoArgs, packed);
+        } else {
+            (packArg(packed, args), ...);
+            store(buf, when, name, flag, fmt, &formatArgs<Args...>, packed);
+        }
+    }
+
+    /**
+     * Formats the messages of every host thread and drops them. The
+     * messages of each thread are dumped in order, one thread after the
+     * other. Other threads may keep recording meanwhile: the messages of a
+     * thread are taken while its buffer is locked, and func is called
+     * once no buffer is locked, so it may record messages itself.
+     */
+    void dump(const DumpFunc &func);
+
+    /** Number of messages dropped since the last dump because they were
+     *  too large to fit in a chunk. */
+    uint64_t droppedMessages() const;
+
+  private:
+    using FormatFunc = void (*)(std::ostream &os, const char *fmt,
+                                const char *args);
+
+    /** Start of each message in a chunk. */
+    struct Header
+    {
+        Tick when;
+        const char *fmt;
+        FormatFunc format;
+        /** Size of the message including this header. */
+        uint32_t size;
+        uint16_t nameLen;
+        uint16_t flagLen;
+    };
+
+    /** Messages recorded by one host thread. */
+    struct Buffer
+    {
+        /** Guards all but scratch, which only the owner uses. */
+        UncontendedMutex mutex;
+        /** The thread recording to the buffer. */
+        std::thread::id owner;
+        std::vector<char> data;
+        /** Bytes used in each chunk. */
+        std::vector<size_t> used;
+        /** Chunk the next message goes to. */
+        size_t current = 0;
+        uint64_t dropped = 0;
+        /** Where the arguments are packed before being stored. */
+        std::string scratch;
+    };
+
+    /** @{ */
+    /** Arguments that are copied as they are. */
+    template <typename T>
+    static constexpr bool isRawArg = std::is_arithmetic_v<T> ||
+        std::is_enum_v<T> ||
+        (std::is_pointer_v<T> &&
+         !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>);
+
+    /** Type an argument is given to cprintf with when formatted. */
+    template <typename T>
+    using Stored = std::conditional_t<isRawArg<std::decay_t<T>>,
+                                      std::decay_t<T>, const char *>;
+    /** @} */
+
+    static void
+    packString(std::string &packed, const char *str, size_t len)
+    {
+        const uint32_t len32 = len;
+        packed.append(reinterpret_cast<const char *>(&len32),
+                      sizeof(len32));
+        packed.append(str, len);
+        packed.push_back('\0');
+    }
+
+    template <typename T>
+    static void
+    packArg(std::string &packed, const T &arg)
+    {
+        using D = std::decay_t<T>;
+        if constexpr (isRawArg<D>) {
+            const D value = arg;
+            packed.append(reinterpret_cast<const char *>(&value),
+                          sizeof(value));
+        } else if constexpr (std::is_convertible_v<const T &,
+                                                   const char *>) {
+            const char *str = arg;
+            if (!str)
+                str = "(null)";
+            packString(packed, str, std::strlen(str));
+        } else if constexpr (std::is_same_v<D, std::string>) {
+            packString(packed, arg.data(), arg.size());
+        } else {
+            std::ostringstream os;
+            os << arg;
+            const std::string str = os.str();
+            packString(packed, str.data(), str.size());
+        }
+    }
+
+    template <typename S>
+    static S
+    unpackArg(const char *&args)
+    {
+        if constexpr (std::is_same_v<S, const char *>) {
+            uint32_t len;
+            std::memcpy(&len, args, sizeof(len));
+            const char *str = args + sizeof(len);
+            args = str + len + 1;
+            return str;
+        } else {
+            S value;
+            std::memcpy(&value, args, sizeof(value));
+            args += sizeof(value);
+            return value;
+        }
+    }
+
+    template <typename ...Args>
+    static void
+    formatArgs(std::ostream &os, const char *fmt, const char *args)
+    {
+        // The elements of a braced list are evaluated in order
+        std::tuple<Stored<Args>...> values{unpackArg<Stored<Args>>(args)...};
+        std::apply([&](const auto &...value) {
+            ccprintf(os, fmt, value...);
+        }, values);
+    }
+
+    static void
+    formatNoArgs(std::ostream &os, const char *, const char *args)
+    {
+        ccprintf(os, unpackArg<const char *>(args));
+    }
+
+    /** The buffer of the calling host thread. */
+    Buffer &localBuffer();
+
+    /** Finds or creates the buffer of the calling host thread when it is
+     *  not the one it used last. */
+    Buffer &findLocalBuffer();
+
+    /** Copies a message to a buffer, locking it. */
+    void store(Buffer &buf, Tick when, const std::string &name,
+               const std::string &flag, const char *fmt, FormatFunc format,
+               const std::string &packed);
+
+    /** Unique identifier of the recorder, for the host thread caches. */
+    const uint64_t id;
+
+    /** Size of a chunk of the buffers, in bytes. */
+    const size_t chunkSize;
+
+    /** Number of chunks of the buffers. */
+    const size_t numChunks;
+
+    /** Buffers of all the host threads, guarded by buffersMutex. */
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    mutable std::mutex buffersMutex;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_FLIGHT_RECORDER_HH__
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/flight_recorder.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Dumped
+{
+    Tick when;
+    std::string name;
+    std::string message;
+};
+
+std::vector<Dumped>
+dumpAll(trace::FlightRecorder &recorder)
+{
+    std::vector<Dumped> dumped;
+    recorder.dump([&](Tick when, const std::string &name,
+                      const std::string &, const std::string &message) {
+        dumped.push_back({when, name, message});
+    });
+    return dumped;
+}
+
+} // anonymous namespace
+
+TEST(FlightRecorderTest, DumpsInOrder)
+{
+    trace::FlightRecorder recorder(4096);
+    recorder.record(1, "a", "Flag", "no args\n");
+    recorder.record(2, "b", "Flag", "%d %s\n", 42, std::string("str"));
+
+    auto dumped = dumpAll(recorder);
+    ASSERT_EQ(dumped.size(), 2u);
+    EXPECT_EQ(dumped[0].when, 1);
+    EXPECT_EQ(dumped[0].name, "a");
+    EXPECT_EQ(dumped[0].message, "no args\n");
+    EXPECT_EQ(dumped[1].message, "42 str\n");
+
+    // The messages are dropped once dumped
+    EXPECT_TRUE(dumpAll(recorder).empty());
+}
+
+TEST(FlightRecorderTest, KeepsTheLastMessages)
+{
+    trace::FlightRecorder recorder(1024);
+    for (int i = 0; i < 1000; i++)
+        recorder.record(i, "obj", "Flag", "message %d\n", i);
+
+    auto dumped = dumpAll(recorder);
+    ASSERT_FALSE(dumped.empty());
+    EXPECT_LT(dumped.size(), 1000u);
+    EXPECT_EQ(dumped.back().when, 999);
+    for (size_t i = 1; i < dumped.size(); i++)
+        EXPECT_EQ(dumped[i].when, dumped[i - 1].when + 1);
+}
+
+/** A thread recording to more recorders than its cache has entries keeps
+ *  a single buffer in each. */
+TEST(FlightRecorderTest, ManyRecordersOnOneThread)
+{
+    std::vector<std::unique_ptr<trace::FlightRecorder>> recorders;
+    for (int i = 0; i < 6; i++)
+        recorders.push_back(std::make_unique<trace::FlightRecorder>(4096));
+
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < recorders.size(); i++)
+            recorders[i]->record(round, "obj", "Flag", "%d\n", i);
+    }
+
+    for (size_t i = 0; i < recorders.size(); i++) {
+        auto dumped = dumpAll(*recorders[i]);
+        ASSERT_EQ(dumped.size(), 3u);
+        for (int round = 0; round < 3; round++) {
+            EXPECT_EQ(dumped[round].when, round);
+            EXPECT_EQ(dumped[round].message, std::to_string(i) + "\n");
+        }
+    }
+}
+
+/** Dumping while other threads record only sees whole messages, each
+ *  thread's in order. */
+TEST(FlightRecorderTest, DumpWhileRecording)
+{
+    trace::FlightRecorder recorder(4096);
+    constexpr int num_threads = 4;
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < num_threads; t++) {
+        writers.emplace_back([&recorder, &stop, t]() {
+            const std::string name = "thread" + std::to_string(t);
+            for (Tick when = 0; !stop; when++) {
+                recorder.record(when, name, "Flag", "%s %d\n",
+                                std::string(t + 1, 'x'), when);
+            }
+        });
+    }
+
+    size_t seen = 0;
+    for (int i = 0; i < 200; i++) {
+        std::map<std::string, Tick> last;
+        for (const auto &msg : dumpAll(recorder)) {
+            const int t = msg.name.back() - '0';
+            ASSERT_EQ(msg.message, std::string(t + 1, 'x') + " " +
+                      std::to_string(msg.when) + "\n");
+            auto it = last.find(msg.name);
+            if (it != last.end()) {
+                ASSERT_GT(msg.when, it->second);
+            }
+            last[msg.name] = msg.when;
+            seen++;
+        }
+    }
+    stop = true;
+    for (auto &writer : writers)
+        writer.join();
+
+    EXPECT_GT(seen, 0u);
+}
@@ -41,6 +41,7 @@
 #include "base/logging.hh"
 
 #include <sstream>
+#include <vector>
 
 #include "base/hostinfo.hh"
 
@@ -49,12 +50,30 @@ namespace gem5
 
 namespace {
 
+std::vector<std::function<void()>> &
+exitHooks()
+{
+    // On the heap for the same reason as the loggers below
+    static auto *hooks = new std::vector<std::function<void()>>;
+    return *hooks;
+}
+
 class ExitLogger : public Logger
 {
   public:
     using Logger::Logger;
 
   protected:
+    void
+    exit() override
+    {
+        // A hook that panics must not run the hooks again
+        std::vector<std::function<void()>> hooks;
+        hooks.swap(exitHooks());
+        for (auto &hook : hooks)
+            hook();
+    }
+
     void
     log(const Loc &loc, std::string s) override
     {
@@ -70,11 +89,22 @@ class FatalLogger : public ExitLogger
     using ExitLogger::ExitLogger;
 
   protected:
-    void exit() override { ::exit(1); }
+    void
+    exit() override
+    {
+        ExitLogger::exit();
+        ::exit(1);
+    }
 };
 
 } // anonymous namespace
 
+void
+Logger::addExitHook(const std::function<void()> &hook)
+{
+    exitHooks().push_back(hook);
+}
+
 // We intentionally put all the loggers on the heap to prevent them from being
 // destructed at the end of the program. This make them safe to be used inside
 // destructor of other global objects. Also, we make them function static
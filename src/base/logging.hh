@@ -42,6 +42,7 @@
 #define __BASE_LOGGING_HH__
 
 #include <cassert>
+#include <functional>
 #include <sstream>
 #include <utility>
 
@@ -94,6 +95,12 @@ class Logger
 
     virtual ~Logger() {};
 
+    /**
+     * Add a function called when a panic or fatal is about to end the
+     * simulation, e.g. to dump debug state that would be lost otherwise.
+     */
+    static void addExitHook(const std::function<void()> &hook);
+
     template<typename ...Args> void
     print(const Loc &loc, const char *format, const Args &...args)
     {
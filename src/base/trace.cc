@@ -169,5 +169,50 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     }
 }
 
+FlightRecorderLogger::FlightRecorderLogger(size_t size, Logger *out_)
+    : buffer(size), out(out_)
+{
+    recorder = &buffer;
+}
+
+void
+FlightRecorderLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    // Messages formatted elsewhere, e.g. by dump()
+    if (isEnabled(name))
+        buffer.record(when, name, flag, "%s", message);
+}
+
+void
+FlightRecorderLogger::dumpMessages()
+{
+    std::ostream &os = out->getOstream();
+    const uint64_t dropped = buffer.droppedMessages();
+    bool any = false;
+    buffer.dump([&](Tick when, const std::string &name,
+                    const std::string &flag, const std::string &message) {
+        if (!any) {
+            ccprintf(os, "---- Flight recorder: last messages ----\n");
+            any = true;
+        }
+        out->logMessage(when, name, flag, message);
+    });
+    if (dropped) {
+        ccprintf(os, "Flight recorder: %d messages too large to record\n",
+                 dropped);
+    }
+    if (any)
+        ccprintf(os, "---- Flight recorder: end of the messages ----\n");
+    os.flush();
+}
+
+void
+dumpFlightRecorder()
+{
+    if (auto *recorder = dynamic_cast<FlightRecorderLogger *>(debug_logger))
+        recorder->dumpMessages();
+}
+
 } // namespace trace
 } // namespace gem5
@@ -39,6 +39,7 @@
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
 #include "base/debug.hh"
+#include "base/flight_recorder.hh"
 #include "base/logging.hh"
 #include "base/match.hh"
 #include "base/types.hh"
@@ -64,6 +65,10 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
+    /** Where the messages are recorded instead of being formatted, if
+     *  they are. See FlightRecorderLogger. */
+    FlightRecorder *recorder = nullptr;
+
     bool isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
@@ -96,6 +101,10 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if (recorder) {
+            recorder->record(when, name, flag, fmt, args...);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -148,6 +157,38 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/** Logger keeping the last messages in memory, which only formats and
+ *  passes them to another logger when they are dumped. This makes
+ *  tracing cheap enough to be left on, with the messages leading to a
+ *  problem dumped when it happens. */
+class FlightRecorderLogger : public Logger
+{
+  protected:
+    FlightRecorder buffer;
+
+    /** Logger the messages are dumped to */
+    Logger *out;
+
+  public:
+    /**
+     * @param size Size of the buffer of each host thread, in bytes.
+     * @param out_ Logger to dump the messages to.
+     */
+    FlightRecorderLogger(size_t size, Logger *out_);
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    std::ostream &getOstream() override { return out->getOstream(); }
+
+    /** Pass the recorded messages to the output logger and drop them */
+    void dumpMessages();
+};
+
+/** Dump the messages of the global debug logger if it is a flight
+ *  recorder, otherwise do nothing */
+void dumpFlightRecorder();
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
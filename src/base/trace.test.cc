@@ -30,6 +30,7 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/gtest/logging.hh"
@@ -685,3 +686,91 @@ TEST(TraceTest, GlobalName)
     DPRINTF(TraceTestDebugFlag, "Test message");
     ASSERT_EQ(getString(trace::output()), "");
 }
+
+/** Test that the flight recorder only formats messages when dumped. */
+TEST(TraceTest, FlightRecorderDump)
+{
+    std::stringstream ss;
+    trace::OstreamLogger out(ss);
+    trace::FlightRecorderLogger logger(4096, &out);
+
+    logger.dprintf_flag(Tick(100), "Foo", "", "Test %s %c %d %x\n",
+        "message", 'A', 217, 0x30);
+    logger.logMessage(Tick(200), "Bar", "", "Formatted message\n");
+    ASSERT_EQ(getString(&out), "");
+
+    logger.dumpMessages();
+    ASSERT_EQ(getString(&out),
+        "---- Flight recorder: last messages ----\n"
+        "    100: Foo: Test message A 217 30\n"
+        "    200: Bar: Formatted message\n"
+        "---- Flight recorder: end of the messages ----\n");
+
+    // The messages are dropped once dumped
+    logger.dumpMessages();
+    ASSERT_EQ(getString(&out), "");
+}
+
+/** A type the flight recorder has to print when recording it. */
+struct Printable
+{
+    int value;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Printable &printable)
+{
+    return os << "<" << printable.value << ">";
+}
+
+/** Test that the flight recorder copies the arguments it needs. */
+TEST(TraceTest, FlightRecorderCopiesArgs)
+{
+    std::stringstream ss;
+    trace::OstreamLogger out(ss);
+    trace::FlightRecorderLogger logger(4096, &out);
+
+    {
+        std::string name = "Foo";
+        std::string arg = "message";
+        std::string fmt = "Test temporary format\n";
+        logger.dprintf_flag(Tick(100), name, "", "Test %s %d\n", arg,
+            Printable{42});
+        logger.dprintf_flag(Tick(100), name, "", fmt.c_str());
+        name = arg = fmt = "Overwritten";
+    }
+
+    logger.dumpMessages();
+    ASSERT_EQ(getString(&out),
+        "---- Flight recorder: last messages ----\n"
+        "    100: Foo: Test message <42>\n"
+        "    100: Foo: Test temporary format\n"
+        "---- Flight recorder: end of the messages ----\n");
+}
+
+/** Test that the flight recorder keeps the most recent messages. */
+TEST(TraceTest, FlightRecorderWraps)
+{
+    std::stringstream ss;
+    trace::OstreamLogger out(ss);
+    trace::FlightRecorderLogger logger(2048, &out);
+
+    for (int i = 0; i < 1000; i++)
+        logger.dprintf_flag(Tick(i), "", "", "Message %d\n", i);
+    logger.dumpMessages();
+
+    std::istringstream lines(getString(&out));
+    std::string line;
+    std::vector<std::string> messages;
+    while (std::getline(lines, line))
+        messages.push_back(line);
+
+    // Some messages were overwritten, the others are in order
+    ASSERT_GT(messages.size(), 10);
+    ASSERT_LT(messages.size(), 1000);
+    EXPECT_EQ(messages[messages.size() - 2], "    999: Message 999");
+    for (size_t i = 2; i < messages.size() - 1; i++) {
+        EXPECT_EQ(messages[i].substr(0, 7),
+                  csprintf("%7d", std::stoi(messages[i - 1]) + 1));
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the pool of host threads.
+ */
+
+#include "base/worker_pool.hh"
+
+#include <algorithm>
+#include <utility>
+
+namespace gem5
+{
+
+WorkerPool::WorkerPool(unsigned num_threads)
+    : numThreads(std::max(1u, num_threads)), state(new State)
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->stopping = true;
+    }
+    state->added.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+}
+
+void
+WorkerPool::work()
+{
+    State &s = *state;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    while (true) {
+        s.added.wait(lock, [&s]() {
+            return s.stopping || !s.tasks.empty();
+        });
+        if (s.tasks.empty())
+            return;
+
+        auto task = std::move(s.tasks.front());
+        s.tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+
+        if (--s.pending == 0)
+            s.completed.notify_all();
+    }
+}
+
+void
+WorkerPool::run(std::function<void()> task)
+{
+    if (threads.empty()) {
+        threads.reserve(numThreads);
+        for (unsigned i = 0; i < numThreads; i++)
+            threads.emplace_back(&WorkerPool::work, this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->tasks.push_back(std::move(task));
+        state->pending++;
+    }
+    state->added.notify_one();
+}
+
+void
+WorkerPool::wait()
+{
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->completed.wait(lock, [this]() { return state->pending == 0; });
+}
+
+void
+WorkerPool::notifyFork()
+{
+    // The threads of the parent don't exist here, so they can't be
+    // joined, and the synchronization objects they were waiting on may
+    // still count them as waiters
+    for (auto &thread : threads)
+        thread.detach();
+    threads.clear();
+    state.release();
+    state.reset(new State);
+}
+
+} // namespace gem5
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A fixed pool of host threads running tasks off the simulation thread.
+ */
+
+#ifndef __BASE_WORKER_POOL_HH__
+#define __BASE_WORKER_POOL_HH__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * A fixed number of host threads running the tasks given to the pool,
+ * in the order they are given. The threads are started with the first
+ * task, so that pools which are never used cost nothing, and run until
+ * the pool is destroyed, which waits for the tasks left.
+ */
+class WorkerPool
+{
+  private:
+    /** State shared with the threads. */
+    struct State
+    {
+        std::mutex mutex;
+        /** Signalled when a task is added, or when stopping. */
+        std::condition_variable added;
+        /** Signalled when a task completes. */
+        std::condition_variable completed;
+        std::deque<std::function<void()>> tasks;
+        /** Number of tasks given but not completed yet. */
+        size_t pending = 0;
+        bool stopping = false;
+    };
+
+    const unsigned numThreads;
+    std::unique_ptr<State> state;
+    std::vector<std::thread> threads;
+
+    void work();
+
+  public:
+    /** @param num_threads Number of threads, at least one. */
+    explicit WorkerPool(unsigned num_threads = 1);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /** Run a task on one of the threads. */
+    void run(std::function<void()> task);
+
+    /** Wait for all the tasks given so far to complete. */
+    void wait();
+
+    /**
+     * Start over in a forked child process, which has none of the
+     * threads of the pool. The pool must have been idle when forking,
+     * e.g. by waiting for it. The state the threads of the parent shared
+     * is left as it is, as it may look in use to the child.
+     */
+    void notifyFork();
+};
+
+} // namespace gem5
+
+#endif // __BASE_WORKER_POOL_HH__
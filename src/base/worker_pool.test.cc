@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "base/worker_pool.hh"
+
+using namespace gem5;
+
+/** The tasks of a single thread run in order. */
+TEST(WorkerPoolTest, Order)
+{
+    std::vector<int> done;
+    WorkerPool pool(1);
+    for (int i = 0; i < 100; i++)
+        pool.run([&done, i]() { done.push_back(i); });
+    pool.wait();
+    ASSERT_EQ(done.size(), 100u);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(done[i], i);
+}
+
+/** Waiting returns once all the tasks have completed. */
+TEST(WorkerPoolTest, Wait)
+{
+    std::atomic<int> done(0);
+    WorkerPool pool(4);
+    for (int i = 0; i < 16; i++) {
+        pool.run([&done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            done++;
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(done, 16);
+
+    // Waiting on an idle pool returns right away
+    pool.wait();
+}
+
+/** Destroying the pool completes the tasks left. */
+TEST(WorkerPoolTest, Destroy)
+{
+    std::atomic<int> done(0);
+    {
+        WorkerPool pool(2);
+        for (int i = 0; i < 16; i++) {
+            pool.run([&done]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                done++;
+            });
+        }
+    }
+    EXPECT_EQ(done, 16);
+}
+
+/** A pool which was never used starts no thread. */
+TEST(WorkerPoolTest, Unused)
+{
+    WorkerPool pool(8);
+    pool.wait();
+}
+
+/** A forked child can use the pool once notified, like the parent. */
+TEST(WorkerPoolTest, Fork)
+{
+    std::atomic<int> done(0);
+    WorkerPool pool(2);
+    pool.run([&done]() { done++; });
+    pool.wait();
+
+    const pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        pool.notifyFork();
+        for (int i = 0; i < 8; i++)
+            pool.run([&done]() { done++; });
+        pool.wait();
+        _exit(done == 9 ? 0 : 1);
+    }
+
+    int status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    pool.run([&done]() { done++; });
+    pool.wait();
+    EXPECT_EQ(done, 2);
+}
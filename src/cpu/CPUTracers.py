@@ -35,6 +35,17 @@ class ExeTracer(InstTracer):
     cxx_header = "cpu/exetrace.hh"
 
 
+class InstBinTrace(InstTracer):
+    type = "InstBinTrace"
+    cxx_class = "gem5::trace::InstBinTrace"
+    cxx_header = "cpu/inst_bin_trace.hh"
+
+    file_name = Param.String(
+        "insttrace.bin", "Instruction trace output file, shared by all the "
+        "tracers (compressed if it ends with .gz)"
+    )
+
+
 class IntelTrace(InstTracer):
     type = "IntelTrace"
     cxx_class = "gem5::trace::IntelTrace"
@@ -90,6 +90,10 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /** Returns if any time buffer still holds communication that a stage
+     *  has not consumed yet, regardless of the stages' own activity. */
+    bool communicating() const;
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Ring buffer of the speculative history records of a thread.
+ */
+
+#ifndef __CPU_HISTORY_RING_HH__
+#define __CPU_HISTORY_RING_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+/**
+ * Ring buffer of records kept in program order, from the youngest one at
+ * the front to the oldest one at the back. Records are added at the front,
+ * squashes drop them from the front and commits from the back, so they
+ * form a FIFO. The records are stored contiguously and recycled as they
+ * are: once the ring is large enough for the records in flight, adding one
+ * does not allocate, and records holding containers keep their storage.
+ * Growing the ring moves the records, so users that hand out pointers to
+ * them should store pointers in the ring.
+ */
+template <class T>
+class HistoryRing
+{
+  private:
+    /** The records, indexed modulo the capacity. */
+    std::vector<T> slots;
+
+    /** Index of the oldest record. */
+    size_t oldest = 0;
+
+    /** Number of records in use. */
+    size_t count = 0;
+
+    size_t mask() const { return slots.size() - 1; }
+
+    /**
+     * Sets the capacity, keeping the records in use in order. The free
+     * records are moved too, so that they keep their storage.
+     */
+    void
+    resize(size_t capacity)
+    {
+        std::vector<T> new_slots(capacity);
+        for (size_t idx = 0; idx < slots.size(); idx++)
+            new_slots[idx] = std::move(slots[(oldest + idx) & mask()]);
+        slots.swap(new_slots);
+        oldest = 0;
+    }
+
+  public:
+    HistoryRing() : slots(1) {}
+
+    /** Sets the capacity to at least the given number of records. */
+    void
+    reserve(size_t capacity)
+    {
+        capacity = size_t(1) << ceilLog2(std::max<size_t>(1, capacity));
+        if (capacity > slots.size())
+            resize(capacity);
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    /** The youngest record. */
+    T &
+    front()
+    {
+        assert(count);
+        return slots[(oldest + count - 1) & mask()];
+    }
+
+    const T &
+    front() const
+    {
+        assert(count);
+        return slots[(oldest + count - 1) & mask()];
+    }
+
+    /** The oldest record. */
+    T &
+    back()
+    {
+        assert(count);
+        return slots[oldest];
+    }
+
+    const T &
+    back() const
+    {
+        assert(count);
+        return slots[oldest];
+    }
+
+    /**
+     * The idx-th youngest record.
+     * @param idx 0 for the youngest record.
+     */
+    T &
+    operator[](size_t idx)
+    {
+        assert(idx < count);
+        return slots[(oldest + count - 1 - idx) & mask()];
+    }
+
+    const T &
+    operator[](size_t idx) const
+    {
+        assert(idx < count);
+        return slots[(oldest + count - 1 - idx) & mask()];
+    }
+
+    /**
+     * Makes a record the youngest one. The caller must initialise it.
+     * @return The record, which may have been used by an older one.
+     */
+    T &
+    push_front()
+    {
+        if (count == slots.size())
+            resize(2 * slots.size());
+        return slots[(oldest + count++) & mask()];
+    }
+
+    /** Drops the youngest record. */
+    void
+    pop_front()
+    {
+        assert(count);
+        --count;
+    }
+
+    /**
+     * Drops the youngest records.
+     * @param num The number of records to drop.
+     */
+    void
+    pop_front(size_t num)
+    {
+        assert(num <= count);
+        count -= num;
+    }
+
+    /** Drops the oldest record. */
+    void
+    pop_back()
+    {
+        assert(count);
+        oldest = (oldest + 1) & mask();
+        --count;
+    }
+
+    /** Drops all the records. */
+    void clear() { count = 0; }
+};
+
+} // namespace gem5
+
+#endif // __CPU_HISTORY_RING_HH__
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Reading and writing of the binary instruction traces.
+ */
+
+#include "cpu/inst_bin_record.hh"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace gem5
+{
+
+namespace trace {
+
+void
+writeBinInstTraceHeader(std::ostream &os, uint64_t tick_frequency)
+{
+    BinInstTraceHeader header;
+    std::memcpy(header.magic, BinInstTraceHeader::traceMagic,
+                sizeof(header.magic));
+    header.version = BinInstTraceHeader::traceVersion;
+    header.recordSize = sizeof(BinInstRecord);
+    header.tickFrequency = tick_frequency;
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void
+writeBinInstRecords(std::ostream &os, const BinInstRecord *records,
+                    size_t count)
+{
+    os.write(reinterpret_cast<const char *>(records),
+             count * sizeof(BinInstRecord));
+}
+
+bool
+readBinInstTraceHeader(std::istream &is, BinInstTraceHeader &header)
+{
+    is.read(reinterpret_cast<char *>(&header), sizeof(header));
+    return is.gcount() == sizeof(header) &&
+        std::memcmp(header.magic, BinInstTraceHeader::traceMagic,
+                    sizeof(header.magic)) == 0 &&
+        header.version == BinInstTraceHeader::traceVersion &&
+        header.recordSize == sizeof(BinInstRecord);
+}
+
+bool
+readBinInstRecord(std::istream &is, BinInstRecord &record)
+{
+    is.read(reinterpret_cast<char *>(&record), sizeof(record));
+    return is.gcount() == sizeof(record);
+}
+
+BinInstTraceWriter::BinInstTraceWriter(std::ostream &trace_os,
+                                       std::ostream &inst_os,
+                                       uint64_t tick_frequency)
+    : traceOs(trace_os), instOs(inst_os)
+{
+    buffer.reserve(bufferSize);
+    writeBinInstTraceHeader(traceOs, tick_frequency);
+}
+
+void
+BinInstTraceWriter::flush()
+{
+    writeBinInstRecords(traceOs, buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+} // namespace trace
+} // namespace gem5
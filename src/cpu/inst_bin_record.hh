@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Format of the binary instruction traces written by InstBinTrace.
+ */
+
+#ifndef __CPU_INST_BIN_RECORD_HH__
+#define __CPU_INST_BIN_RECORD_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+/**
+ * One executed instruction or micro-op, written in the host byte order.
+ */
+struct BinInstRecord
+{
+    /** Record flags. */
+    enum
+    {
+        MemValid = 0x1,
+        PredicatedFalse = 0x2,
+        Faulting = 0x4,
+        Microop = 0x8,
+        LastMicroop = 0x10,
+        SeqValid = 0x20
+    };
+
+    Tick tick;
+    uint64_t pc;
+    /** Commit sequence number, or fetch sequence number if there is none. */
+    uint64_t seqNum;
+    uint64_t memAddr;
+    /** Last value written, the raw bits of doubles. */
+    uint64_t data;
+    /** Index of the static instruction in the instruction file. */
+    uint32_t inst;
+    uint32_t memFlags;
+    uint16_t upc;
+    uint16_t contextId;
+    uint16_t memSize;
+    /** InstRecord::DataStatus of the data field. */
+    uint8_t dataStatus;
+    uint8_t flags;
+};
+
+static_assert(sizeof(BinInstRecord) == 56);
+
+/**
+ * Header at the beginning of the trace file, followed by the records.
+ */
+struct BinInstTraceHeader
+{
+    static constexpr char traceMagic[8] = {'g', 'e', 'm', '5', 'I', 'N',
+                                           'S', 'T'};
+    static constexpr uint32_t traceVersion = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    /** Simulated ticks per second. */
+    uint64_t tickFrequency;
+};
+
+/**
+ * Write the header of a trace.
+ *
+ * @param os Stream of the trace.
+ * @param tick_frequency Simulated ticks per second.
+ */
+void writeBinInstTraceHeader(std::ostream &os, uint64_t tick_frequency);
+
+/** Write records after the header of a trace. */
+void writeBinInstRecords(std::ostream &os, const BinInstRecord *records,
+                         size_t count);
+
+/**
+ * Read the header of a trace.
+ *
+ * @return Whether the stream holds a trace of this version.
+ */
+bool readBinInstTraceHeader(std::istream &is, BinInstTraceHeader &header);
+
+/**
+ * Read the next record of a trace.
+ *
+ * @return Whether there was a whole record left.
+ */
+bool readBinInstRecord(std::istream &is, BinInstRecord &record);
+
+/**
+ * Writes a binary instruction trace: the header and the records to the
+ * trace stream, and each instruction the records refer to, once, to the
+ * instruction stream. An instruction is a static instruction at a given
+ * PC and micro-PC, as a static instruction shared by several PCs
+ * disassembles differently at each of them.
+ */
+class BinInstTraceWriter
+{
+  public:
+    /**
+     * Writes the header of the trace.
+     *
+     * @param trace_os Stream of the trace.
+     * @param inst_os Stream of the instructions.
+     * @param tick_frequency Simulated ticks per second.
+     */
+    BinInstTraceWriter(std::ostream &trace_os, std::ostream &inst_os,
+                       uint64_t tick_frequency);
+
+    /**
+     * Adds a record to the trace, writing its instruction first if it is
+     * new.
+     *
+     * @param rec The record, but for its instruction index.
+     * @param inst Identifies the static instruction, which must outlive
+     *        the writer.
+     * @param describe Called with the instruction stream to describe the
+     *        instruction, after its index, if it is new.
+     */
+    template <class Describe>
+    void
+    add(BinInstRecord &rec, const void *inst, Describe &&describe)
+    {
+        auto [it, inserted] = instIndex.emplace(
+            InstKey{inst, rec.pc, rec.upc}, instIndex.size());
+        if (inserted) {
+            instOs << it->second << '\t';
+            describe(instOs);
+        }
+
+        rec.inst = it->second;
+        buffer.push_back(rec);
+        if (buffer.size() == bufferSize)
+            flush();
+    }
+
+    /** Writes the buffered records. */
+    void flush();
+
+    /** Number of instructions written so far. */
+    size_t numInsts() const { return instIndex.size(); }
+
+    /** Number of records written at a time. */
+    static constexpr size_t bufferSize = 8192;
+
+  private:
+    struct InstKey
+    {
+        const void *inst;
+        uint64_t pc;
+        uint16_t upc;
+
+        bool
+        operator==(const InstKey &other) const
+        {
+            return inst == other.inst && pc == other.pc && upc == other.upc;
+        }
+    };
+
+    struct InstKeyHash
+    {
+        size_t
+        operator()(const InstKey &key) const
+        {
+            return std::hash<const void *>()(key.inst) ^
+                std::hash<uint64_t>()(key.pc * 31 + key.upc);
+        }
+    };
+
+    std::ostream &traceOs;
+    std::ostream &instOs;
+
+    std::vector<BinInstRecord> buffer;
+
+    /** Index of each instruction written so far. */
+    std::unordered_map<InstKey, uint32_t, InstKeyHash> instIndex;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_INST_BIN_RECORD_HH__
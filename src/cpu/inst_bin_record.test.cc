@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+#include "cpu/inst_bin_record.hh"
+
+using namespace gem5;
+using namespace gem5::trace;
+
+namespace
+{
+
+BinInstRecord
+makeRecord(uint64_t i)
+{
+    BinInstRecord rec;
+    std::memset(&rec, 0, sizeof(rec));
+    rec.tick = 1000 * i;
+    rec.pc = 0x400000 + 4 * i;
+    rec.seqNum = i;
+    rec.memAddr = 0x10000 + 8 * i;
+    rec.data = 0xdeadbeef00000000ULL | i;
+    rec.inst = i % 3;
+    rec.memFlags = 0x40;
+    rec.upc = 1;
+    rec.contextId = 2;
+    rec.memSize = 8;
+    rec.dataStatus = 1;
+    rec.flags = BinInstRecord::MemValid | BinInstRecord::SeqValid;
+    return rec;
+}
+
+} // anonymous namespace
+
+/** Records read back are the ones written, after a valid header. */
+TEST(InstBinRecordTest, RoundTrip)
+{
+    std::stringstream ss;
+    writeBinInstTraceHeader(ss, 1000000000000ULL);
+    BinInstRecord written[3] = {makeRecord(0), makeRecord(1),
+                                makeRecord(2)};
+    writeBinInstRecords(ss, written, 3);
+
+    BinInstTraceHeader header;
+    ASSERT_TRUE(readBinInstTraceHeader(ss, header));
+    EXPECT_EQ(header.tickFrequency, 1000000000000ULL);
+    EXPECT_EQ(header.recordSize, sizeof(BinInstRecord));
+
+    BinInstRecord rec;
+    for (const auto &expected : written) {
+        ASSERT_TRUE(readBinInstRecord(ss, rec));
+        EXPECT_EQ(std::memcmp(&rec, &expected, sizeof(rec)), 0);
+    }
+    EXPECT_FALSE(readBinInstRecord(ss, rec));
+}
+
+/** Streams which are not traces are rejected. */
+TEST(InstBinRecordTest, BadHeader)
+{
+    std::stringstream ss(std::string(sizeof(BinInstTraceHeader), 'x'));
+    BinInstTraceHeader header;
+    EXPECT_FALSE(readBinInstTraceHeader(ss, header));
+}
+
+/** A truncated record is not returned. */
+TEST(InstBinRecordTest, TruncatedRecord)
+{
+    std::stringstream ss;
+    writeBinInstTraceHeader(ss, 1);
+    BinInstRecord rec = makeRecord(1);
+    writeBinInstRecords(ss, &rec, 1);
+    std::string data = ss.str();
+    data.pop_back();
+
+    std::stringstream truncated(data);
+    BinInstTraceHeader header;
+    ASSERT_TRUE(readBinInstTraceHeader(truncated, header));
+    EXPECT_FALSE(readBinInstRecord(truncated, rec));
+}
+
+namespace
+{
+
+/** Describes the instructions by their name and the PC they are at. */
+struct Describer
+{
+    const char *name;
+    int calls = 0;
+
+    void
+    operator()(std::ostream &os, uint64_t pc)
+    {
+        calls++;
+        os << name << " @" << std::hex << pc << std::dec << "\n";
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * The writer gives an index to each static instruction at each PC,
+ * describes it once, and the records it writes refer to it.
+ */
+TEST(InstBinRecordTest, WriterSharedInsts)
+{
+    std::stringstream trace, insts;
+    BinInstTraceWriter writer(trace, insts, 1000);
+
+    // Two static instructions, the first one shared by two PCs, as with
+    // a decode cache
+    Describer add{"add"}, branch{"branch"};
+    const struct { Describer *inst; uint64_t pc; uint16_t upc; } execs[] = {
+        {&add, 0x1000, 0}, {&branch, 0x1004, 0}, {&add, 0x2000, 0},
+        {&add, 0x1000, 0}, {&branch, 0x1004, 0}, {&add, 0x2000, 0},
+        {&add, 0x2000, 1},
+    };
+    const uint32_t expected_index[] = {0, 1, 2, 0, 1, 2, 3};
+
+    for (size_t i = 0; i < std::size(execs); i++) {
+        BinInstRecord rec = makeRecord(i);
+        rec.pc = execs[i].pc;
+        rec.upc = execs[i].upc;
+        Describer &inst = *execs[i].inst;
+        writer.add(rec, &inst, [&](std::ostream &os) { inst(os, rec.pc); });
+        EXPECT_EQ(rec.inst, expected_index[i]);
+    }
+    writer.flush();
+
+    EXPECT_EQ(writer.numInsts(), 4u);
+    EXPECT_EQ(add.calls, 3);
+    EXPECT_EQ(branch.calls, 1);
+    EXPECT_EQ(insts.str(), "0\tadd @1000\n"
+                           "1\tbranch @1004\n"
+                           "2\tadd @2000\n"
+                           "3\tadd @2000\n");
+
+    BinInstTraceHeader header;
+    ASSERT_TRUE(readBinInstTraceHeader(trace, header));
+    EXPECT_EQ(header.tickFrequency, 1000u);
+    BinInstRecord rec;
+    for (size_t i = 0; i < std::size(execs); i++) {
+        ASSERT_TRUE(readBinInstRecord(trace, rec));
+        EXPECT_EQ(rec.pc, execs[i].pc);
+        EXPECT_EQ(rec.inst, expected_index[i]);
+        EXPECT_EQ(rec.seqNum, i);
+    }
+    EXPECT_FALSE(readBinInstRecord(trace, rec));
+}
+
+/** The records are written in blocks, in order. */
+TEST(InstBinRecordTest, WriterFlushesFullBuffers)
+{
+    std::stringstream trace, insts;
+    BinInstTraceWriter writer(trace, insts, 1);
+    Describer inst{"nop"};
+
+    const size_t count = BinInstTraceWriter::bufferSize + 10;
+    for (size_t i = 0; i < count; i++) {
+        BinInstRecord rec = makeRecord(i);
+        writer.add(rec, &inst, [&](std::ostream &os) { inst(os, rec.pc); });
+    }
+
+    // Only the full buffer was written so far
+    EXPECT_EQ(trace.str().size(), sizeof(BinInstTraceHeader) +
+              BinInstTraceWriter::bufferSize * sizeof(BinInstRecord));
+    writer.flush();
+
+    BinInstTraceHeader header;
+    ASSERT_TRUE(readBinInstTraceHeader(trace, header));
+    BinInstRecord rec;
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_TRUE(readBinInstRecord(trace, rec));
+        EXPECT_EQ(rec.seqNum, i);
+    }
+    EXPECT_FALSE(readBinInstRecord(trace, rec));
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the binary instruction tracer.
+ */
+
+#include "cpu/inst_bin_trace.hh"
+
+#include <sstream>
+
+#include "base/loader/symtab.hh"
+#include "base/output.hh"
+#include "cpu/static_inst.hh"
+#include "cpu/thread_context.hh"
+#include "debug/ExecEnable.hh"
+#include "enums/OpClass.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+InstBinTrace::Output *InstBinTrace::output = nullptr;
+
+void
+InstBinTraceRecord::dump()
+{
+    BinInstRecord rec;
+    rec.tick = when;
+    rec.pc = pc->instAddr();
+    rec.seqNum = cp_seq_valid ? cp_seq : fetch_seq;
+    rec.memAddr = mem_valid ? addr : 0;
+    rec.data = dataStatus == DataInvalid || dataStatus == DataReg ?
+        0 : data.asInt;
+    rec.memFlags = mem_valid ? flags : 0;
+    rec.upc = pc->microPC();
+    rec.contextId = thread->contextId();
+    rec.memSize = mem_valid ? size : 0;
+    rec.dataStatus = dataStatus;
+    rec.flags = (mem_valid ? BinInstRecord::MemValid : 0) |
+        (predicate ? 0 : BinInstRecord::PredicatedFalse) |
+        (faulting ? BinInstRecord::Faulting : 0) |
+        (staticInst->isMicroop() ? BinInstRecord::Microop : 0) |
+        (staticInst->isLastMicroop() ? BinInstRecord::LastMicroop : 0) |
+        (cp_seq_valid || fetch_seq_valid ? BinInstRecord::SeqValid : 0);
+
+    tracer.traceInst(rec, staticInst, *pc);
+}
+
+InstBinTrace::Output::Output(OutputStream *trace_stream,
+                             OutputStream *inst_stream)
+    : traceStream(trace_stream), instStream(inst_stream),
+      writer(*trace_stream->stream(), *inst_stream->stream(),
+             sim_clock::Frequency)
+{
+}
+
+InstBinTrace::InstBinTrace(const InstBinTraceParams &p)
+    : InstTracer(p)
+{
+    createTraceFile(p.file_name);
+}
+
+void
+InstBinTrace::createTraceFile(const std::string &file_name)
+{
+    // Since there is only one output file for all tracers check if it exists
+    if (output)
+        return;
+
+    OutputStream *trace_stream = simout.create(file_name, true);
+
+    // Keep the compression suffix last
+    const std::string gz = ".gz";
+    std::string inst_name = file_name + ".insts";
+    if (file_name.size() > gz.size() &&
+        file_name.compare(file_name.size() - gz.size(), gz.size(), gz) == 0) {
+        inst_name = file_name.substr(0, file_name.size() - gz.size()) +
+            ".insts" + gz;
+    }
+    output = new Output(trace_stream, simout.create(inst_name));
+
+    // get a callback when we exit so we can close the files
+    registerExitCallback([]() { closeStreams(); });
+}
+
+void
+InstBinTrace::closeStreams()
+{
+    if (!output)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(output->mutex);
+        output->writer.flush();
+    }
+    simout.close(output->traceStream);
+    simout.close(output->instStream);
+    delete output;
+    output = nullptr;
+}
+
+InstRecord *
+InstBinTrace::getInstRecord(Tick when, ThreadContext *tc,
+                            const StaticInstPtr si, const PCStateBase &pc,
+                            const StaticInstPtr mi)
+{
+    // Only record the trace if Exec debugging is enabled, and the files
+    // are still open
+    if (!debug::ExecEnable || !output)
+        return nullptr;
+
+    return new InstBinTraceRecord(*this, when, tc, si, pc, mi);
+}
+
+void
+InstBinTrace::describeInst(std::ostream &os, const StaticInstPtr &si,
+                           const PCStateBase &pc)
+{
+    output->insts.push_back(si);
+
+    auto &bytes = output->instBytes;
+    size_t size = si->asBytes(bytes.data(), bytes.size());
+    if (size > bytes.size()) {
+        bytes.resize(size);
+        size = si->asBytes(bytes.data(), bytes.size());
+    }
+
+    for (size_t i = 0; i < size; i++)
+        ccprintf(os, "%02x", bytes[i]);
+    ccprintf(os, "\t%s\t", enums::OpClassStrings[si->opClass()]);
+    for (int i = 0; i < si->numDestRegs(); i++)
+        os << (i ? "," : "") << si->destRegIdx(i);
+    ccprintf(os, "\t%s\n",
+             disassemble(si, pc, &loader::debugSymbolTable));
+}
+
+void
+InstBinTrace::traceInst(BinInstRecord &rec, const StaticInstPtr &si,
+                        const PCStateBase &pc)
+{
+    if (!output)
+        return;
+
+    std::lock_guard<std::mutex> lock(output->mutex);
+    output->writer.add(rec, si.get(), [&](std::ostream &os) {
+        describeInst(os, si, pc);
+    });
+}
+
+} // namespace trace
+} // namespace gem5
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Instruction tracer writing fixed size binary records, a cheaper
+ * alternative to the Exec debug output for long traces.
+ */
+
+#ifndef __CPU_INST_BIN_TRACE_HH__
+#define __CPU_INST_BIN_TRACE_HH__
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/types.hh"
+#include "cpu/inst_bin_record.hh"
+#include "cpu/static_inst_fwd.hh"
+#include "params/InstBinTrace.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+class OutputStream;
+class ThreadContext;
+
+namespace trace {
+
+class InstBinTrace;
+
+class InstBinTraceRecord : public InstRecord
+{
+  public:
+    InstBinTraceRecord(InstBinTrace &_tracer, Tick when, ThreadContext *tc,
+                       const StaticInstPtr si, const PCStateBase &pc,
+                       const StaticInstPtr mi=nullptr)
+        : InstRecord(when, tc, si, pc, mi), tracer(_tracer)
+    {}
+
+    void dump() override;
+
+  protected:
+    InstBinTrace &tracer;
+};
+
+/**
+ * Records the instructions executed by the CPUs as BinInstRecord, when
+ * the ExecEnable debug flag is set. The per instruction work is limited
+ * to filling a record in a buffer written to the trace file in blocks.
+ *
+ * Each static instruction is disassembled once per PC it executes at,
+ * the first time it does, and written to a second file named after the
+ * trace with an .insts extension. Each line of that file is the index the
+ * records refer to, the bytes of the instruction, its op class, its
+ * destination registers and its disassembly, separated by tabs. Files
+ * whose name ends in .gz are compressed. util/inst-bin-trace2txt.py prints
+ * the trace in a format close to the one of the Exec debug flags.
+ *
+ * Like the Exec debug flags, a record only holds the last value the
+ * instruction wrote, as kept by InstRecord, and no value for vector
+ * registers.
+ *
+ * All the tracers write to the same files, the records telling the
+ * threads apart with their context ID. The files are shared by CPUs
+ * which may be simulated on different host threads, so they are only
+ * accessed with their mutex held.
+ */
+class InstBinTrace : public InstTracer
+{
+  public:
+    InstBinTrace(const InstBinTraceParams &p);
+
+    InstRecord *getInstRecord(Tick when, ThreadContext *tc,
+                              const StaticInstPtr si, const PCStateBase &pc,
+                              const StaticInstPtr mi=nullptr) override;
+
+  protected:
+    /** The files, shared by all the tracers. */
+    struct Output
+    {
+        Output(OutputStream *trace_stream, OutputStream *inst_stream);
+
+        std::mutex mutex;
+
+        OutputStream *traceStream;
+        OutputStream *instStream;
+
+        BinInstTraceWriter writer;
+
+        /** The instructions written so far, kept alive so that their
+         *  address is not reused. */
+        std::vector<StaticInstPtr> insts;
+
+        /** Buffer for the bytes of the instructions. */
+        std::vector<uint8_t> instBytes;
+    };
+
+    static Output *output;
+
+    void createTraceFile(const std::string &file_name);
+
+    /** Writes the buffered records and closes the files. */
+    static void closeStreams();
+
+    /**
+     * Adds a record to the trace.
+     *
+     * @param rec The record, but for its instruction index.
+     * @param si Instruction the record is about.
+     * @param pc PC of the instruction, to disassemble it.
+     */
+    void traceInst(BinInstRecord &rec, const StaticInstPtr &si,
+                   const PCStateBase &pc);
+
+    /**
+     * Describes an instruction in the instruction file, with the mutex
+     * held.
+     */
+    void describeInst(std::ostream &os, const StaticInstPtr &si,
+                      const PCStateBase &pc);
+
+    friend class InstBinTraceRecord;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_INST_BIN_TRACE_HH__
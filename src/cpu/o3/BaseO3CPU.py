@@ -93,6 +93,18 @@ class BaseO3CPU(BaseCPU):
         cls.numPhysFloatRegs.value = value
 
     activity = Param.Unsigned(0, "Initial count")
+    skip_quiescent_cycles = Param.Bool(
+        False,
+        "Stop ticking while no stage can make progress until an external "
+        "event (e.g. a memory response) arrives, and credit the per-cycle "
+        "stats of the skipped cycles on wake-up. Only used with one thread.",
+    )
+    pipeTraceFile = Param.String(
+        "",
+        "File in the output directory to write a binary pipeline trace to, "
+        "compressed if the name ends in .gz. Empty to disable. Convert it "
+        "with util/o3-pipeview-bin2txt.py.",
+    )
 
     cacheStorePorts = Param.Unsigned(
         200, "Cache Ports. Constrains stores only."
@@ -123,6 +135,11 @@ class BaseO3CPU(BaseCPU):
     commitToRenameDelay = Param.Cycles(1, "Commit to rename delay")
     decodeToRenameDelay = Param.Cycles(1, "Decode to rename delay")
     renameWidth = Param.Unsigned(8, "Rename width")
+    numRenameCheckpoints = Param.Unsigned(
+        0,
+        "Number of rename map checkpoints per thread taken at control "
+        "instructions to speed up squashes, 0 to disable them",
+    )
 
     commitToIEWDelay = Param.Cycles(
         1, "Commit to Issue/Execute/Writeback delay"
@@ -57,6 +57,24 @@ namespace gem5
 namespace o3
 {
 
+/**
+ * The structs below travel through TimeBuffers, which call their reset()
+ * every cycle to get an empty struct back instead of re-constructing it.
+ * reset() must clear every field, but only pays for what was written.
+ */
+
+/**
+ * Release the instructions held in an insts[] array. Stages fill it from
+ * index 0 without leaving holes, so the first empty slot marks the end of
+ * what was written this cycle.
+ */
+inline void
+resetInsts(DynInstPtr (&insts)[MaxWidth])
+{
+    for (int i = 0; i < MaxWidth && insts[i]; ++i)
+        insts[i] = nullptr;
+}
+
 /** Struct that defines the information passed from fetch to decode. */
 struct FetchStruct
 {
@@ -66,6 +84,16 @@ struct FetchStruct
     Fault fetchFault;
     InstSeqNum fetchFaultSN;
     bool clearFetchFault;
+
+    void
+    reset()
+    {
+        size = 0;
+        resetInsts(insts);
+        fetchFault = NoFault;
+        fetchFaultSN = 0;
+        clearFetchFault = false;
+    }
 };
 
 /** Struct that defines the information passed from decode to rename. */
@@ -74,6 +102,13 @@ struct DecodeStruct
     int size;
 
     DynInstPtr insts[MaxWidth];
+
+    void
+    reset()
+    {
+        size = 0;
+        resetInsts(insts);
+    }
 };
 
 /** Struct that defines the information passed from rename to IEW. */
@@ -82,6 +117,13 @@ struct RenameStruct
     int size;
 
     DynInstPtr insts[MaxWidth];
+
+    void
+    reset()
+    {
+        size = 0;
+        resetInsts(insts);
+    }
 };
 
 /** Struct that defines the information passed from IEW to commit. */
@@ -99,6 +141,24 @@ struct IEWStruct
     bool branchMispredict[MaxThreads];
     bool branchTaken[MaxThreads];
     bool includeSquashInst[MaxThreads];
+
+    void
+    reset()
+    {
+        size = 0;
+        resetInsts(insts);
+        for (ThreadID tid = 0; tid < MaxThreads; tid++) {
+            if (mispredictInst[tid])
+                mispredictInst[tid] = nullptr;
+            mispredPC[tid] = 0;
+            squashedSeqNum[tid] = 0;
+            pc[tid].reset();
+            squash[tid] = false;
+            branchMispredict[tid] = false;
+            branchTaken[tid] = false;
+            includeSquashInst[tid] = false;
+        }
+    }
 };
 
 struct IssueStruct
@@ -106,6 +166,13 @@ struct IssueStruct
     int size;
 
     DynInstPtr insts[MaxWidth];
+
+    void
+    reset()
+    {
+        size = 0;
+        resetInsts(insts);
+    }
 };
 
 /** Struct that defines all backwards communication. */
@@ -124,6 +191,24 @@ struct TimeStruct
         bool predIncorrect;
         bool branchMispredict;
         bool branchTaken;
+
+        void
+        reset()
+        {
+            nextPC.reset();
+            if (mispredictInst)
+                mispredictInst = nullptr;
+            if (squashInst)
+                squashInst = nullptr;
+            doneSeqNum = 0;
+            mispredPC = 0;
+            branchAddr = 0;
+            branchCount = 0;
+            squash = false;
+            predIncorrect = false;
+            branchMispredict = false;
+            branchTaken = false;
+        }
     };
 
     DecodeComm decodeInfo[MaxThreads];
@@ -147,6 +232,8 @@ struct TimeStruct
         unsigned dispatched;
         bool usedIQ;
         bool usedLSQ;
+
+        void reset() { *this = IewComm(); }
     };
 
     IewComm iewInfo[MaxThreads];
@@ -213,6 +300,28 @@ struct TimeStruct
         /// the IEW stage.
         bool strictlyOrdered; // *I
 
+        void
+        reset()
+        {
+            pc.reset();
+            if (mispredictInst)
+                mispredictInst = nullptr;
+            if (squashInst)
+                squashInst = nullptr;
+            if (strictlyOrderedLoad)
+                strictlyOrderedLoad = nullptr;
+            nonSpecSeqNum = 0;
+            doneSeqNum = 0;
+            freeROBEntries = 0;
+            squash = false;
+            robSquashing = false;
+            usedROB = false;
+            emptyROB = false;
+            branchTaken = false;
+            interruptPending = false;
+            clearInterrupt = false;
+            strictlyOrdered = false;
+        }
     };
 
     CommitComm commitInfo[MaxThreads];
@@ -223,6 +332,22 @@ struct TimeStruct
     bool renameUnblock[MaxThreads];
     bool iewBlock[MaxThreads];
     bool iewUnblock[MaxThreads];
+
+    void
+    reset()
+    {
+        for (ThreadID tid = 0; tid < MaxThreads; tid++) {
+            decodeInfo[tid].reset();
+            iewInfo[tid].reset();
+            commitInfo[tid].reset();
+            decodeBlock[tid] = false;
+            decodeUnblock[tid] = false;
+            renameBlock[tid] = false;
+            renameUnblock[tid] = false;
+            iewBlock[tid] = false;
+            iewUnblock[tid] = false;
+        }
+    }
 };
 
 } // namespace o3
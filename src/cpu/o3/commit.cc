@@ -350,6 +350,30 @@ Commit::isDrained() const
         interrupt == NoFault;
 }
 
+bool
+Commit::isQuiescent(ThreadID tid)
+{
+    if ((commitStatus[tid] != Running && commitStatus[tid] != Idle) ||
+        trapSquash[tid] || tcSquash[tid] || drainPending ||
+        interrupt != NoFault || (FullSystem && cpu->checkInterrupts(0))) {
+        return false;
+    }
+
+    if (rob->isEmpty(tid)) {
+        // The empty ROB is still to be signalled to the other stages
+        return !checkEmptyROB[tid];
+    }
+
+    // The stall probe fires every cycle the head is not ready
+    return !rob->isHeadReady(tid) && !ppCommitStall->hasListeners();
+}
+
+void
+Commit::creditQuiescentCycles(ThreadID tid, Cycles cycles)
+{
+    stats.numCommittedDist.sample(0, cycles);
+}
+
 void
 Commit::takeOverFrom()
 {
@@ -1273,7 +1297,7 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
     wib->retireHead();
 
 #if TRACING_ON
-    if (debug::O3PipeView) {
+    if (cpu->tracePipeline()) {
         head_inst->commitTick = curTick() - head_inst->fetchTick;
     }
 #endif
@@ -55,6 +55,7 @@
 #include "debug/O3CPU.hh"
 #include "debug/Quiesce.hh"
 #include "enums/MemoryMode.hh"
+#include "sim/core.hh"
 #include "sim/cur_tick.hh"
 #include "sim/full_system.hh"
 #include "sim/process.hh"
@@ -114,6 +115,8 @@ CPU::CPU(const BaseO3CPUParams &params)
 
       globalSeqNum(1),
       system(params.system),
+      skipQuiescentCycles(params.skip_quiescent_cycles),
+      skippingCycles(false),
       lastRunningCycle(curCycle()),
       cpuStats(this)
 {
@@ -320,6 +323,14 @@ CPU::CPU(const BaseO3CPUParams &params)
         fatal("O3CPU %s has no interrupt controller.\n"
               "Ensure createInterruptController() is called.\n", name());
     }
+
+    if (!params.pipeTraceFile.empty()) {
+        fatal_if(!TRACING_ON, "%s: The pipeline trace needs a build with "
+                 "tracing enabled.", name());
+        pipeTrace = std::make_unique<PipeTraceWriter>(params.pipeTraceFile);
+        // The CPU is not destroyed at exit, the trace would not be flushed
+        registerExitCallback([this]() { pipeTrace->close(); });
+    }
 }
 
 void
@@ -337,6 +348,7 @@ CPU::regProbePoints()
     rename.regProbePoints();
     iew.regProbePoints();
     commit.regProbePoints();
+    wib.regProbePoints();
 }
 
 CPU::CPUStats::CPUStats(CPU *cpu)
@@ -349,7 +361,10 @@ CPU::CPUStats::CPUStats(CPU *cpu)
                "to idling"),
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
-               "for an interrupt")
+               "for an interrupt"),
+      ADD_STAT(quiescentCycles, statistics::units::Cycle::get(),
+               "Total number of cycles skipped while no stage could make "
+               "progress")
 {
     // Register any of the O3CPU's stats here.
     timesIdled
@@ -385,6 +400,8 @@ CPU::tick()
 
     commit.tick();
 
+    wib.sampleOccupancy();
+
     // Now advance the time buffers
     timeBuffer.advance();
 
@@ -408,6 +425,10 @@ CPU::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (skipQuiescentCycles && isQuiescent()) {
+            DPRINTF(O3CPU, "Quiescent, skipping cycles!\n");
+            lastRunningCycle = curCycle();
+            skippingCycles = true;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -519,6 +540,9 @@ CPU::activateContext(ThreadID tid)
 {
     assert(!switchedOut());
 
+    if (skippingCycles)
+        endQuiescentSkip();
+
     // Needs to set each stage to running as well.
     activateThread(tid);
 
@@ -558,6 +582,9 @@ CPU::suspendContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Suspending Thread Context.\n", tid);
     assert(!switchedOut());
 
+    if (skippingCycles)
+        endQuiescentSkip();
+
     deactivateThread(tid);
 
     // If this was the last thread then unschedule the tick event.
@@ -579,6 +606,9 @@ CPU::haltContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Halt Context called. Deallocating\n", tid);
     assert(!switchedOut());
 
+    if (skippingCycles)
+        endQuiescentSkip();
+
     deactivateThread(tid);
     removeThread(tid);
 
@@ -1315,9 +1345,65 @@ CPU::wakeDependents(const DynInstPtr &inst)
     iew.wakeDependents(inst);
 }
 */
+bool
+CPU::isQuiescent()
+{
+    // The stages keep per-thread state that is only checked for a single
+    // thread, and pending communication always means more work
+    if (numThreads != 1 || activeThreads.size() != 1 ||
+        _status != Running || drainState() != DrainState::Running ||
+        activityRec.communicating()) {
+        return false;
+    }
+
+    const ThreadID tid = activeThreads.front();
+
+    return commit.isQuiescent(tid) && iew.isQuiescent(tid) &&
+        rename.isQuiescent(tid) && decode.isQuiescent(tid) &&
+        fetch.isQuiescent(tid);
+}
+
+void
+CPU::endQuiescentSkip()
+{
+    assert(skippingCycles);
+    skippingCycles = false;
+
+    // The stages are in the same state as in the last cycle that ran, so
+    // every skipped cycle would have updated the same stats
+    if (curCycle() > lastRunningCycle + 1) {
+        Cycles cycles(curCycle() - lastRunningCycle - 1);
+        const ThreadID tid = activeThreads.front();
+
+        DPRINTF(Activity, "Crediting %i quiescent cycles.\n", cycles);
+
+        baseStats.numCycles += cycles;
+        cpuStats.quiescentCycles += cycles;
+        fetch.creditQuiescentCycles(tid, cycles);
+        decode.creditQuiescentCycles(tid, cycles);
+        rename.creditQuiescentCycles(tid, cycles);
+        iew.creditQuiescentCycles(tid, cycles);
+        commit.creditQuiescentCycles(tid, cycles);
+        wib.creditQuiescentCycles(cycles);
+    }
+}
+
 void
 CPU::wakeCPU()
 {
+    if (skippingCycles) {
+        DPRINTF(Activity, "Waking up CPU from quiescent cycles\n");
+
+        endQuiescentSkip();
+
+        // Do not tick again in the cycle that already ran
+        if (curCycle() > lastRunningCycle)
+            schedule(tickEvent, clockEdge());
+        else
+            schedule(tickEvent, clockEdge(Cycles(1)));
+        return;
+    }
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
@@ -1339,6 +1425,10 @@ CPU::wakeCPU()
 void
 CPU::wakeup(ThreadID tid)
 {
+    // An interrupt may have been posted while skipping quiescent cycles
+    if (skippingCycles)
+        wakeCPU();
+
     if (thread[tid]->status() != gem5::ThreadContext::Suspended)
         return;
 
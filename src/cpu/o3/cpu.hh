@@ -45,6 +45,7 @@
 
 #include <iostream>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
@@ -59,6 +60,7 @@
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/pipe_trace.hh"
 #include "cpu/o3/rename.hh"
 #include "cpu/o3/rob.hh"
 #include "cpu/o3/wib.hh"
@@ -68,6 +70,7 @@
 #include "cpu/base.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/timebuf.hh"
+#include "debug/O3PipeView.hh"
 #include "params/BaseO3CPU.hh"
 #include "sim/process.hh"
 
@@ -487,15 +490,44 @@ class CPU : public BaseCPU
      */
     ActivityRecorder activityRec;
 
+    /**
+     * Whether to stop ticking during quiescent cycles, in which no stage
+     * can make progress until an event from outside the pipeline (memory
+     * response, FU completion, interrupt, ...) arrives. Any such event
+     * wakes the CPU, which then credits the per-cycle stats of the cycles
+     * it skipped.
+     */
+    const bool skipQuiescentCycles;
+
+    /** Set while the tick event is descheduled during quiescent cycles. */
+    bool skippingCycles;
+
+    /** Can no stage make progress until an external event arrives? */
+    bool isQuiescent();
+
+    /**
+     * Stops skipping quiescent cycles, crediting the stats of the cycles
+     * skipped since lastRunningCycle. The caller reschedules the tick.
+     */
+    void endQuiescentSkip();
+
   public:
     /** Records that there was time buffer activity this cycle. */
-    void activityThisCycle() { activityRec.activity(); }
+    void
+    activityThisCycle()
+    {
+        activityRec.activity();
+        if (skippingCycles)
+            wakeCPU();
+    }
 
     /** Changes a stage's status to active within the activity recorder. */
     void
     activateStage(const StageIdx idx)
     {
         activityRec.activateStage(idx);
+        if (skippingCycles)
+            wakeCPU();
     }
 
     /** Changes a stage's status to inactive within the activity recorder. */
@@ -577,6 +609,16 @@ class CPU : public BaseCPU
         return iew.ldstQueue.getDataPort();
     }
 
+    /** Binary pipeline trace, if one is written. */
+    std::unique_ptr<PipeTraceWriter> pipeTrace;
+
+    /** Should the instructions record the ticks of the pipeline stages? */
+    bool
+    tracePipeline() const
+    {
+        return debug::O3PipeView || pipeTrace;
+    }
+
     struct CPUStats : public statistics::Group
     {
         CPUStats(CPU *cpu);
@@ -588,6 +630,8 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for total number of quiescent cycles that were skipped. */
+        statistics::Scalar quiescentCycles;
     } cpuStats;
 
   public:
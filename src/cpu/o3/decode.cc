@@ -213,6 +213,29 @@ Decode::isDrained() const
     return true;
 }
 
+bool
+Decode::isQuiescent(ThreadID tid)
+{
+    switch (decodeStatus[tid]) {
+      case Blocked:
+        return checkStall(tid);
+      case Running:
+      case Idle:
+        return !checkStall(tid) && insts[tid].empty();
+      default:
+        return false;
+    }
+}
+
+void
+Decode::creditQuiescentCycles(ThreadID tid, Cycles cycles)
+{
+    if (decodeStatus[tid] == Blocked)
+        stats.blockedCycles += cycles;
+    else
+        stats.idleCycles += cycles;
+}
+
 bool
 Decode::checkStall(ThreadID tid) const
 {
@@ -687,7 +710,7 @@ Decode::decodeInsts(ThreadID tid)
         --insts_available;
 
 #if TRACING_ON
-        if (debug::O3PipeView) {
+        if (cpu->tracePipeline()) {
             inst->decodeTick = curTick() - inst->fetchTick;
         }
 #endif
@@ -218,6 +218,9 @@ DynInst::~DynInst()
         _readySrcIdx[i].~uint8_t();
 
 #if TRACING_ON
+    if (cpu->pipeTrace && fetchTick != -1)
+        cpu->pipeTrace->record(*this);
+
     if (debug::O3PipeView) {
         Tick fetch = fetchTick;
         // fetchTick can be -1 if the instruction fetched outside the trace
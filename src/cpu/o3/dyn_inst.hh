@@ -1002,6 +1002,8 @@ class DynInst : public ExecContext, public RefCounted
     int32_t completeTick = -1;
     int32_t commitTick = -1;
     int32_t storeTick = -1;
+    int32_t wibEnterTick = -1;  // instruction first enters the WIB
+    int32_t wibExitTick = -1;   // instruction last leaves the WIB
 #endif
 
     /* Values used by LoadToUse stat */
@@ -422,6 +422,63 @@ Fetch::isDrained() const
     return !finishTranslationEvent.scheduled();
 }
 
+bool
+Fetch::isQuiescent(ThreadID tid)
+{
+    // Instructions waiting in the fetch queue would be sent to decode
+    if (stalls[tid].drain ||
+        (!fetchQueue[tid].empty() && !stalls[tid].decode)) {
+        return false;
+    }
+
+    switch (fetchStatus[tid]) {
+      case IcacheWaitResponse:
+      case ItlbWait:
+      case Idle:
+        return true;
+      case Running:
+        {
+            // With a full fetch queue fetch spins on the current fetch
+            // buffer, unless it needs another block from the I-cache
+            if (fetchQueue[tid].size() < fetchQueueSize)
+                return false;
+
+            const Addr fetch_addr = (pc[tid]->instAddr() + fetchOffset[tid]) &
+                decoder[tid]->pcMask();
+            return fetchBufferValid[tid] &&
+                fetchBufferAlignPC(fetch_addr) == fetchBufferPC[tid];
+        }
+      default:
+        return false;
+    }
+}
+
+void
+Fetch::creditQuiescentCycles(ThreadID tid, Cycles cycles)
+{
+    fetchStats.nisnDist.sample(0, cycles);
+
+    switch (fetchStatus[tid]) {
+      case IcacheWaitResponse:
+        cpu->fetchStats[tid]->icacheStallCycles += cycles;
+        break;
+      case ItlbWait:
+        fetchStats.tlbCycles += cycles;
+        break;
+      case Idle:
+        fetchStats.idleCycles += cycles;
+        break;
+      case Running:
+        if (checkInterrupt(pc[tid]->instAddr()) && !delayedCommit[tid])
+            fetchStats.miscStallCycles += cycles;
+        else
+            fetchStats.cycles += cycles;
+        break;
+      default:
+        panic("Fetch status %i is not quiescent.", fetchStatus[tid]);
+    }
+}
+
 void
 Fetch::takeOverFrom()
 {
@@ -1255,7 +1312,7 @@ Fetch::fetch(bool &status_change)
             numInst++;
 
 #if TRACING_ON
-            if (debug::O3PipeView) {
+            if (cpu->tracePipeline()) {
                 instruction->fetchTick = curTick();
             }
 #endif
@@ -348,6 +348,36 @@ IEW::isDrained() const
     return drained;
 }
 
+bool
+IEW::isQuiescent(ThreadID tid)
+{
+    if (exeStatus != Idle || updateLSQNextCycle || !wib->isBufferEmpty() ||
+        ldstQueue.willWB() || !instQueue.isQuiescent()) {
+        return false;
+    }
+
+    switch (dispatchStatus[tid]) {
+      case Blocked:
+        return checkStall(tid);
+      case Running:
+      case Idle:
+        return !checkStall(tid) && insts[tid].empty();
+      default:
+        return false;
+    }
+}
+
+void
+IEW::creditQuiescentCycles(ThreadID tid, Cycles cycles)
+{
+    if (dispatchStatus[tid] == Blocked)
+        iewStats.blockCycles += cycles;
+
+    // Read by updateStatus() every cycle
+    instQueue.iqIOStats.intInstQueueReads += cycles;
+    instQueue.creditQuiescentCycles(cycles);
+}
+
 void
 IEW::drainSanityCheck() const
 {
@@ -1553,7 +1583,7 @@ IEW::updateExeInstStats(const DynInstPtr& inst)
     cpu->executeStats[tid]->numInsts++;
 
 #if TRACING_ON
-    if (debug::O3PipeView) {
+    if (cpu->tracePipeline()) {
         inst->completeTick = curTick() - inst->fetchTick;
     }
 #endif
@@ -166,6 +166,16 @@ class IEW
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /**
+     * Is the stage unable to make progress until an event from outside
+     * the pipeline (e.g. a memory response) wakes the CPU up? Assumes no
+     * communication is in flight between the stages.
+     */
+    bool isQuiescent(ThreadID tid);
+
+    /** Credits the per-cycle stats of the cycles skipped while quiescent. */
+    void creditQuiescentCycles(ThreadID tid, Cycles cycles);
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
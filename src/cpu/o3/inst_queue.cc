@@ -470,6 +470,21 @@ InstructionQueue::isDrained() const
     return drained;
 }
 
+bool
+InstructionQueue::isQuiescent()
+{
+    // Blocked memory instructions wait for the cache to unblock, which
+    // wakes the CPU up
+    return !hasReadyInsts() && instsToExecute.empty() &&
+        deferredMemInsts.empty() && retryMemInsts.empty();
+}
+
+void
+InstructionQueue::creditQuiescentCycles(Cycles cycles)
+{
+    iqStats.numIssuedDist.sample(0, cycles);
+}
+
 void
 InstructionQueue::drainSanityCheck() const
 {
@@ -159,6 +159,12 @@ class InstructionQueue
     /** Determine if we are drained. */
     bool isDrained() const;
 
+    /** Is the IQ waiting on events only, with nothing to issue or retry? */
+    bool isQuiescent();
+
+    /** Credits the per-cycle stats of the cycles skipped while quiescent. */
+    void creditQuiescentCycles(Cycles cycles);
+
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
 
@@ -1162,7 +1162,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
             store_inst->seqNum, store_idx.idx() - 1, storeQueue.head() - 1);
 
 #if TRACING_ON
-    if (debug::O3PipeView) {
+    if (cpu->tracePipeline()) {
         store_inst->storeTick =
             curTick() - store_inst->fetchTick;
     }
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the binary pipeline trace writer.
+ */
+
+#include "cpu/o3/pipe_trace.hh"
+
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "cpu/o3/dyn_inst.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+PipeTraceWriter::PipeTraceWriter(const std::string &file_name)
+{
+    buffer.reserve(bufferSize);
+
+    traceStream = simout.create(file_name, true);
+
+    // Keep the compression suffix last
+    const std::string gz = ".gz";
+    std::string disasm_name = file_name + ".disasm";
+    if (file_name.size() > gz.size() &&
+        file_name.compare(file_name.size() - gz.size(), gz.size(), gz) == 0) {
+        disasm_name = file_name.substr(0, file_name.size() - gz.size()) +
+            ".disasm" + gz;
+    }
+    disasmStream = simout.create(disasm_name);
+
+    PipeTraceHeader header;
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.recordSize = sizeof(PipeTraceRecord);
+    traceStream->stream()->write(reinterpret_cast<const char *>(&header),
+                                 sizeof(header));
+}
+
+PipeTraceWriter::~PipeTraceWriter()
+{
+    close();
+}
+
+void
+PipeTraceWriter::record(const DynInst &inst)
+{
+#if TRACING_ON
+    // Instructions are still destroyed after the files are closed at exit
+    if (!traceStream)
+        return;
+
+    const std::string &disasm =
+        inst.staticInst->disassemble(inst.pcState().instAddr());
+    auto [it, inserted] = disasmIndex.emplace(disasm, disasmIndex.size());
+    if (inserted)
+        *disasmStream->stream() << disasm << '\n';
+
+    PipeTraceRecord &rec = buffer.emplace_back();
+    rec.seqNum = inst.seqNum;
+    rec.pc = inst.pcState().instAddr();
+    rec.fetch = inst.fetchTick;
+    rec.disasm = it->second;
+    rec.upc = inst.pcState().microPC();
+    rec.threadId = inst.threadNumber;
+    rec.decode = inst.decodeTick;
+    rec.rename = inst.renameTick;
+    rec.dispatch = inst.dispatchTick;
+    rec.issue = inst.issueTick;
+    rec.complete = inst.completeTick;
+    rec.commit = inst.commitTick;
+    rec.store = inst.storeTick;
+    rec.wibEnter = inst.wibEnterTick;
+    rec.wibExit = inst.wibExitTick;
+    rec.reserved = 0;
+
+    if (buffer.size() == bufferSize)
+        flush();
+#else
+    panic("The pipeline trace needs a build with tracing enabled.");
+#endif
+}
+
+void
+PipeTraceWriter::flush()
+{
+    traceStream->stream()->write(
+        reinterpret_cast<const char *>(buffer.data()),
+        buffer.size() * sizeof(PipeTraceRecord));
+    buffer.clear();
+}
+
+void
+PipeTraceWriter::close()
+{
+    if (!traceStream)
+        return;
+
+    flush();
+    simout.close(traceStream);
+    simout.close(disasmStream);
+    traceStream = nullptr;
+    disasmStream = nullptr;
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Binary version of the O3PipeView trace, with one fixed size record per
+ * instruction.
+ */
+
+#ifndef __CPU_O3_PIPE_TRACE_HH__
+#define __CPU_O3_PIPE_TRACE_HH__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class OutputStream;
+
+namespace o3
+{
+
+class DynInst;
+
+/**
+ * The pipeline ticks of one instruction. The stage ticks are relative to
+ * the fetch tick, or -1 if the instruction never reached the stage, as in
+ * DynInst. The records are written in the host byte order.
+ */
+struct PipeTraceRecord
+{
+    uint64_t seqNum;
+    uint64_t pc;
+    Tick fetch;
+    /** Index of the disassembly in the disassembly file. */
+    uint32_t disasm;
+    uint16_t upc;
+    uint16_t threadId;
+    int32_t decode;
+    int32_t rename;
+    int32_t dispatch;
+    int32_t issue;
+    int32_t complete;
+    int32_t commit;
+    int32_t store;
+    /** First time the instruction was moved into the WIB. */
+    int32_t wibEnter;
+    /** Last time the instruction was released from the WIB. */
+    int32_t wibExit;
+    /** Always 0, pads the record to a multiple of 8 bytes. */
+    uint32_t reserved;
+};
+
+static_assert(sizeof(PipeTraceRecord) == 72);
+
+/**
+ * Header at the beginning of the trace file, followed by the records.
+ */
+struct PipeTraceHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+/**
+ * Writes the pipeline ticks of the instructions as PipeTraceRecord to a
+ * file, and their disassembly to a second file named after the first one
+ * with a .disasm extension, one string per line. Each disassembly string
+ * is written once, the records refer to it by its line number.
+ *
+ * Records are gathered in a buffer and written in blocks. Files whose name
+ * ends in .gz are compressed. The records are the same as the
+ * O3PipeView debug flag prints, and util/o3-pipeview-bin2txt.py converts
+ * them back to that format.
+ */
+class PipeTraceWriter
+{
+  public:
+    static constexpr char magic[8] = {'g', 'e', 'm', '5', 'O', '3', 'P',
+                                      'T'};
+    static constexpr uint32_t version = 1;
+
+    /**
+     * @param file_name File to create in the output directory.
+     */
+    PipeTraceWriter(const std::string &file_name);
+    ~PipeTraceWriter();
+
+    /** Records an instruction, once it cannot reach any other stage. */
+    void record(const DynInst &inst);
+
+    /** Writes the buffered records and closes the files. */
+    void close();
+
+  private:
+    void flush();
+
+    /** Number of records written at a time. */
+    static constexpr size_t bufferSize = 4096;
+
+    std::vector<PipeTraceRecord> buffer;
+
+    OutputStream *traceStream;
+    OutputStream *disasmStream;
+
+    /** Index of each disassembly string written so far. */
+    std::unordered_map<std::string, uint32_t> disasmIndex;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_PIPE_TRACE_HH__
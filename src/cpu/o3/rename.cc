@@ -59,7 +59,8 @@ namespace o3
 {
 
 Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
-    : cpu(_cpu),
+    : numCheckpoints(params.numRenameCheckpoints),
+      cpu(_cpu),
       iewToRenameDelay(params.iewToRenameDelay),
       decodeToRenameDelay(params.decodeToRenameDelay),
       commitToRenameDelay(params.commitToRenameDelay),
@@ -86,6 +87,18 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
         serializeInst[tid] = nullptr;
         serializeOnNextInst[tid] = false;
     }
+
+    // Every renamed register holds a physical register until it commits,
+    // so this many history entries are enough for all but the registers
+    // that are not renamed.
+    const size_t max_renames = params.numPhysIntRegs +
+        params.numPhysFloatRegs + params.numPhysVecRegs +
+        params.numPhysVecPredRegs + params.numPhysMatRegs +
+        params.numPhysCCRegs;
+    for (ThreadID tid = 0; tid < MaxThreads; tid++) {
+        historyBuffer[tid].reserve(max_renames);
+        checkpoints[tid].reserve(numCheckpoints);
+    }
 }
 
 std::string
@@ -140,6 +153,12 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
                "Number of HB maps that are committed"),
       ADD_STAT(undoneMaps, statistics::units::Count::get(),
                "Number of HB maps that are undone due to squashing"),
+      ADD_STAT(undoneMapsPerSquash, statistics::units::Count::get(),
+               "Number of rename map entries written per squash"),
+      ADD_STAT(checkpointsTaken, statistics::units::Count::get(),
+               "Number of rename map checkpoints taken"),
+      ADD_STAT(checkpointRestores, statistics::units::Count::get(),
+               "Number of squashes restoring a rename map checkpoint"),
       ADD_STAT(serializing, statistics::units::Count::get(),
                "count of serializing insts renamed"),
       ADD_STAT(tempSerializing, statistics::units::Count::get(),
@@ -173,6 +192,11 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
 
     committedMaps.prereq(committedMaps);
     undoneMaps.prereq(undoneMaps);
+    undoneMapsPerSquash
+        .init(0, 255, 16)
+        .flags(statistics::pdf);
+    checkpointsTaken.prereq(checkpointsTaken);
+    checkpointRestores.prereq(checkpointRestores);
     serializing.flags(statistics::total);
     tempSerializing.flags(statistics::total);
     skidInsts.flags(statistics::total);
@@ -245,6 +269,8 @@ Rename::clearStates(ThreadID tid)
     storesInProgress[tid] = 0;
 
     serializeOnNextInst[tid] = false;
+
+    checkpoints[tid].clear();
 }
 
 void
@@ -275,6 +301,9 @@ Rename::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+
+        // The rename map may have been changed under the checkpoints.
+        checkpoints[tid].clear();
     }
 }
 
@@ -318,6 +347,33 @@ Rename::isDrained() const
     return true;
 }
 
+bool
+Rename::isQuiescent(ThreadID tid)
+{
+    // Registers of squashed instructions are freed on the next tick
+    if (!freeingInProgress[tid].empty())
+        return false;
+
+    switch (renameStatus[tid]) {
+      case Blocked:
+        return checkStall(tid);
+      case Running:
+      case Idle:
+        return !checkStall(tid) && insts[tid].empty();
+      default:
+        return false;
+    }
+}
+
+void
+Rename::creditQuiescentCycles(ThreadID tid, Cycles cycles)
+{
+    if (renameStatus[tid] == Blocked)
+        stats.blockCycles += cycles;
+    else
+        stats.idleCycles += cycles;
+}
+
 void
 Rename::takeOverFrom()
 {
@@ -797,7 +853,7 @@ Rename::sortInsts()
         const DynInstPtr &inst = fromDecode->insts[i];
         insts[inst->threadNumber].push_back(inst);
 #if TRACING_ON
-        if (debug::O3PipeView) {
+        if (cpu->tracePipeline()) {
             inst->renameTick = curTick() - inst->fetchTick;
         }
 #endif
@@ -914,20 +970,29 @@ Rename::unblock(ThreadID tid)
 void
 Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
-    auto hb_it = historyBuffer[tid].begin();
+    HistoryRing<MapCheckpoint> &cps = checkpoints[tid];
+    while (!cps.empty() && cps.front().instSeqNum > squashed_seq_num)
+        cps.pop_front();
+
+    // The youngest checkpoint left holds the map from before all the
+    // entries below. It was taken at or before the last surviving
+    // instruction.
+    const bool restore = !cps.empty();
+
+    HistoryRing<RenameHistory> &hb = historyBuffer[tid];
+    unsigned map_writes = 0;
 
     // After a syscall squashes everything, the history buffer may be empty
     // but the ROB may still be squashing instructions.
     // Go through the most recent instructions, undoing the mappings
     // they did and freeing up the registers.
-    while (!historyBuffer[tid].empty() &&
-           hb_it->instSeqNum > squashed_seq_num) {
-        assert(hb_it != historyBuffer[tid].end());
+    while (!hb.empty() && hb.front().instSeqNum > squashed_seq_num) {
+        RenameHistory &entry = hb.front();
 
         DPRINTF(Rename, "[tid:%i] Removing history entry with sequence "
                 "number %i (archReg: %d, newPhysReg: %d, prevPhysReg: %d).\n",
-                tid, hb_it->instSeqNum, hb_it->archReg.index(),
-                hb_it->newPhysReg->index(), hb_it->prevPhysReg->index());
+                tid, entry.instSeqNum, entry.archReg.index(),
+                entry.newPhysReg->index(), entry.prevPhysReg->index());
 
         // Undo the rename mapping only if it was really a change.
         // Special regs that are not really renamed (like misc regs
@@ -935,45 +1000,99 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // is the same as the old one.  While it would be merely a
         // waste of time to update the rename table, we definitely
         // don't want to put these on the free list.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
+        if (entry.newPhysReg != entry.prevPhysReg) {
             // Tell the rename map to set the architected register to the
-            // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            // previous physical register that it was renamed to, unless
+            // the checkpoint will.
+            if (!restore) {
+                renameMap[tid]->setEntry(entry.archReg, entry.prevPhysReg);
+                ++map_writes;
+            }
 
             // The phys regs can still be owned by squashing but
             // executing instructions in IEW at this moment. To avoid
             // ownership hazard in SMT CPU, we delay the freelist update
             // until they are indeed squashed in the commit stage.
-            freeingInProgress[tid].push_back(hb_it->newPhysReg);
+            freeingInProgress[tid].push_back(entry.newPhysReg);
         }
 
         // Notify potential listeners that the register mapping needs to be
         // removed because the instruction it was mapped to got squashed. Note
-        // that this is done before hb_it is incremented.
-        ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
-                                                hb_it->newPhysReg));
+        // that this is done before the entry is dropped.
+        ppSquashInRename->notify(std::make_pair(entry.instSeqNum,
+                                                entry.newPhysReg));
 
-        historyBuffer[tid].erase(hb_it++);
+        hb.pop_front();
 
         ++stats.undoneMaps;
     }
+
+    if (restore) {
+        DPRINTF(Rename, "[tid:%i] Restoring rename map checkpoint [sn:%llu]."
+                "\n", tid, cps.front().instSeqNum);
+        map_writes += restoreCheckpoint(cps.front(), tid);
+        ++stats.checkpointRestores;
+    }
+
+    stats.undoneMapsPerSquash.sample(map_writes);
+}
+
+unsigned
+Rename::restoreCheckpoint(MapCheckpoint &cp, ThreadID tid)
+{
+    UnifiedRenameMap *map = renameMap[tid];
+    unsigned map_writes = 0;
+
+    // Bring back the mappings overwritten since the checkpoint. The older
+    // checkpoints already hold them, and the checkpoint records them again
+    // when they are next renamed.
+    for (const auto &[arch_reg, phys_reg] : cp.undo) {
+        map->setEntry(arch_reg, phys_reg);
+        checkpointStamps[tid][arch_reg.classValue()][arch_reg.index()] =
+            cp.id - 1;
+        ++map_writes;
+    }
+    cp.undo.clear();
+
+    // Replay the renames of the surviving instructions younger than the
+    // checkpoint, from the oldest one.
+    HistoryRing<RenameHistory> &hb = historyBuffer[tid];
+    size_t num_younger = 0;
+    while (num_younger < hb.size() &&
+           hb[num_younger].instSeqNum > cp.instSeqNum) {
+        num_younger++;
+    }
+    while (num_younger--) {
+        const RenameHistory &entry = hb[num_younger];
+        if (entry.newPhysReg != entry.prevPhysReg) {
+            recordOverwrite(entry.archReg, entry.prevPhysReg, tid);
+            map->setEntry(entry.archReg, entry.newPhysReg);
+            ++map_writes;
+        }
+    }
+
+    return map_writes;
 }
 
 void
 Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
 {
+    HistoryRing<RenameHistory> &hb = historyBuffer[tid];
+
     DPRINTF(Rename, "[tid:%i] Removing a committed instruction from the "
             "history buffer %u (size=%i), until [sn:%llu].\n",
-            tid, tid, historyBuffer[tid].size(), inst_seq_num);
-
-    auto hb_it = historyBuffer[tid].end();
+            tid, tid, hb.size(), inst_seq_num);
 
-    --hb_it;
+    // Checkpoints of committed instructions can never be restored.
+    while (!checkpoints[tid].empty() &&
+           checkpoints[tid].back().instSeqNum <= inst_seq_num) {
+        checkpoints[tid].pop_back();
+    }
 
-    if (historyBuffer[tid].empty()) {
+    if (hb.empty()) {
         DPRINTF(Rename, "[tid:%i] History buffer is empty.\n", tid);
         return;
-    } else if (hb_it->instSeqNum > inst_seq_num) {
+    } else if (hb.back().instSeqNum > inst_seq_num) {
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Old sequence number encountered. "
                 "Ensure that a syscall happened recently.\n",
@@ -985,26 +1104,25 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
     // number. Some or even all of the committed instructions may not have
     // rename histories if they did not have destination registers that were
     // renamed.
-    while (!historyBuffer[tid].empty() &&
-           hb_it != historyBuffer[tid].end() &&
-           hb_it->instSeqNum <= inst_seq_num) {
+    while (!hb.empty() && hb.back().instSeqNum <= inst_seq_num) {
+        RenameHistory &entry = hb.back();
 
         DPRINTF(Rename, "[tid:%i] Freeing up older rename of reg %i (%s), "
                 "[sn:%llu].\n",
-                tid, hb_it->prevPhysReg->index(),
-                hb_it->prevPhysReg->className(),
-                hb_it->instSeqNum);
+                tid, entry.prevPhysReg->index(),
+                entry.prevPhysReg->className(),
+                entry.instSeqNum);
 
         // Don't free special phys regs like misc and zero regs, which
         // can be recognized because the new mapping is the same as
         // the old one.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
-            freeList->addReg(hb_it->prevPhysReg);
+        if (entry.newPhysReg != entry.prevPhysReg) {
+            freeList->addReg(entry.prevPhysReg);
         }
 
         ++stats.committedMaps;
 
-        historyBuffer[tid].erase(hb_it--);
+        hb.pop_back();
     }
 }
 
@@ -1110,16 +1228,17 @@ Rename::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
                 rename_result.first->index(),
                 rename_result.first->flatIndex());
 
-        // Record the rename information so that a history can be kept.
-        RenameHistory hb_entry(inst->seqNum, flat_dest_regid,
-                               rename_result.first,
-                               rename_result.second);
+        if (rename_result.first != rename_result.second)
+            recordOverwrite(flat_dest_regid, rename_result.second, tid);
 
-        historyBuffer[tid].push_front(hb_entry);
+        // Record the rename information so that a history can be kept.
+        historyBuffer[tid].push_front() =
+            RenameHistory(inst->seqNum, flat_dest_regid,
+                          rename_result.first, rename_result.second);
 
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Adding instruction to history buffer (size=%i).\n",
-                tid,(*historyBuffer[tid].begin()).instSeqNum,
+                tid, historyBuffer[tid].front().instSeqNum,
                 historyBuffer[tid].size());
 
         // Tell the instruction to rename the appropriate destination
@@ -1133,6 +1252,10 @@ Rename::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
 
         ++stats.renamedOperands;
     }
+
+    // Mispredicted branches are where most squashes land.
+    if (numCheckpoints && inst->isControl())
+        checkpointMap(inst, tid);
 }
 
 int
@@ -1420,26 +1543,55 @@ Rename::incrFullStat(const FullSource &source)
 }
 
 void
-Rename::dumpHistory()
+Rename::checkpointMap(const DynInstPtr &inst, ThreadID tid)
 {
-    std::list<RenameHistory>::iterator buf_it;
+    if (checkpoints[tid].size() >= numCheckpoints)
+        return;
 
-    for (ThreadID tid = 0; tid < numThreads; tid++) {
+    // The slot keeps the storage of the undo log it held.
+    MapCheckpoint &cp = checkpoints[tid].push_front();
+    cp.instSeqNum = inst->seqNum;
+    cp.id = ++lastCheckpointId;
+    cp.undo.clear();
 
-        buf_it = historyBuffer[tid].begin();
+    ++stats.checkpointsTaken;
+}
+
+void
+Rename::recordOverwrite(const RegId &arch_reg, PhysRegIdPtr prev_reg,
+                        ThreadID tid)
+{
+    HistoryRing<MapCheckpoint> &cps = checkpoints[tid];
+    if (cps.empty())
+        return;
+
+    auto &stamps = checkpointStamps[tid][arch_reg.classValue()];
+    if (arch_reg.index() >= stamps.size())
+        stamps.resize(arch_reg.index() + 1, 0);
+    uint64_t &stamp = stamps[arch_reg.index()];
 
-        while (buf_it != historyBuffer[tid].end()) {
+    // Only the checkpoints taken since the register was last renamed miss
+    // its mapping, and they are the youngest ones.
+    for (size_t idx = 0; idx < cps.size() && cps[idx].id > stamp; idx++)
+        cps[idx].undo.emplace_back(arch_reg, prev_reg);
+    stamp = cps.front().id;
+}
+
+void
+Rename::dumpHistory()
+{
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        for (size_t idx = 0; idx < historyBuffer[tid].size(); idx++) {
+            const RenameHistory &entry = historyBuffer[tid][idx];
             cprintf("Seq num: %i\nArch reg[%s]: %i New phys reg:"
                     " %i[%s] Old phys reg: %i[%s]\n",
-                    (*buf_it).instSeqNum,
-                    (*buf_it).archReg.className(),
-                    (*buf_it).archReg.index(),
-                    (*buf_it).newPhysReg->index(),
-                    (*buf_it).newPhysReg->className(),
-                    (*buf_it).prevPhysReg->index(),
-                    (*buf_it).prevPhysReg->className());
-
-            buf_it++;
+                    entry.instSeqNum,
+                    entry.archReg.className(),
+                    entry.archReg.index(),
+                    entry.newPhysReg->index(),
+                    entry.newPhysReg->className(),
+                    entry.prevPhysReg->index(),
+                    entry.prevPhysReg->className());
         }
     }
 }
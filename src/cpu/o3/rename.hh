@@ -42,16 +42,21 @@
 #ifndef __CPU_O3_RENAME_HH__
 #define __CPU_O3_RENAME_HH__
 
+#include <array>
+#include <cstdint>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "base/statistics.hh"
+#include "cpu/history_ring.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/rename_map.hh"
 #include "cpu/timebuf.hh"
 #include "sim/probe/probe.hh"
 
@@ -184,6 +189,16 @@ class Rename
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /**
+     * Is the stage unable to make progress until an event from outside
+     * the pipeline (e.g. a memory response) wakes the CPU up? Assumes no
+     * communication is in flight between the stages.
+     */
+    bool isQuiescent(ThreadID tid);
+
+    /** Credits the per-cycle stats of the cycles skipped while quiescent. */
+    void creditQuiescentCycles(ThreadID tid, Cycles cycles);
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -296,6 +311,11 @@ class Rename
      */
     struct RenameHistory
     {
+        RenameHistory()
+            : instSeqNum(0), newPhysReg(nullptr), prevPhysReg(nullptr)
+        {
+        }
+
         RenameHistory(InstSeqNum _instSeqNum, const RegId& _archReg,
                       PhysRegIdPtr _newPhysReg,
                       PhysRegIdPtr _prevPhysReg)
@@ -315,10 +335,68 @@ class Rename
         PhysRegIdPtr prevPhysReg;
     };
 
-    /** A per-thread list of all destination register renames, used to either
-     * undo rename mappings or free old physical registers.
+    /** A checkpoint of the rename map of a thread, taken right after a
+     * control instruction was renamed. Rather than a copy of the map, it
+     * keeps the mappings that the later renames overwrote, each register
+     * at most once, which is enough to bring the map back.
+     */
+    struct MapCheckpoint
+    {
+        /** The sequence number of the control instruction. */
+        InstSeqNum instSeqNum = 0;
+        /** Increases with each checkpoint taken, never 0. */
+        uint64_t id = 0;
+        /** The mappings at the checkpoint of the registers renamed since. */
+        std::vector<std::pair<RegId, PhysRegIdPtr>> undo;
+    };
+
+    /** A per-thread buffer of all destination register renames, used to
+     * either undo rename mappings or free old physical registers. It is
+     * sized for the physical registers so it does not need to grow.
+     */
+    HistoryRing<RenameHistory> historyBuffer[MaxThreads];
+
+    /** Takes a checkpoint of the rename map of a thread, if one is free.
+     * @param inst The control instruction that was just renamed.
+     * @param tid The thread id.
+     */
+    void checkpointMap(const DynInstPtr &inst, ThreadID tid);
+
+    /** Records a mapping about to be overwritten in the checkpoints that
+     * were taken since the register was last renamed.
+     * @param arch_reg The architectural register being renamed.
+     * @param prev_reg The physical register it is mapped to.
+     * @param tid The thread id.
+     */
+    void recordOverwrite(const RegId &arch_reg, PhysRegIdPtr prev_reg,
+                         ThreadID tid);
+
+    /** Brings the rename map of a thread back to a checkpoint.
+     * @param cp The checkpoint, the youngest one of the thread.
+     * @param tid The thread id.
+     * @return The number of rename map entries written.
+     */
+    unsigned restoreCheckpoint(MapCheckpoint &cp, ThreadID tid);
+
+    /** Maximum number of rename map checkpoints per thread. */
+    const unsigned numCheckpoints;
+
+    /** The id of the last checkpoint taken. */
+    uint64_t lastCheckpointId = 0;
+
+    /** Per thread and register class, the id of the youngest checkpoint
+     * when each architectural register was last renamed. The checkpoints
+     * with a larger id have not recorded its mapping yet.
+     */
+    std::array<std::vector<uint64_t>, CCRegClass + 1>
+        checkpointStamps[MaxThreads];
+
+    /** Per-thread rename map checkpoints taken at control instructions.
+     * A squash restores the map from the youngest checkpoint it does not
+     * squash, then replays the few history entries younger than it,
+     * instead of undoing the squashed history entries one by one.
      */
-    std::list<RenameHistory> historyBuffer[MaxThreads];
+    HistoryRing<MapCheckpoint> checkpoints[MaxThreads];
 
     /** Pointer to CPU. */
     CPU *cpu;
@@ -530,6 +608,14 @@ class Rename
         /** Stat for total number of mappings that were undone due to a
          *  squash. */
         statistics::Scalar undoneMaps;
+        /** Distribution of the number of rename map entries written to
+         *  roll back each squash. */
+        statistics::Distribution undoneMapsPerSquash;
+        /** Number of rename map checkpoints taken. */
+        statistics::Scalar checkpointsTaken;
+        /** Number of squashes that restored the rename map from a
+         *  checkpoint. */
+        statistics::Scalar checkpointRestores;
         /** Number of serialize instructions handled. */
         statistics::Scalar serializing;
         /** Number of instructions marked as temporarily serializing. */
@@ -1,5 +1,6 @@
 #include "cpu/o3/wib.hh"
 
+#include <algorithm>
 #include <list>
 #include <queue>
 
@@ -19,8 +20,9 @@ WIB::WIB(CPU *_cpu, IEW *iewStage,
     : cpu(_cpu),
       iewStage(iewStage),
       numEntries(params.numWIBEntries), //need to add to params
-      squashWidth(1)
-      // stats(_cpu)
+      squashWidth(1),
+      stats(_cpu, params.numWIBEntries, params.numWIBEntries),
+      ppInsert(nullptr), ppRelease(nullptr), ppSquash(nullptr)
 {
     // numLoads = (int)(numEntries * 0.25);
     numLoads = numEntries;
@@ -41,6 +43,7 @@ WIB::WIB(CPU *_cpu, IEW *iewStage,
     for (auto& row : bitMatrix) {
         row.resize(numLoads, false); // Initialize new bits to false
     }
+    rowInfo.resize(numEntries);
 
     resetState();
 }
@@ -54,8 +57,11 @@ WIB::resetState()
     for (auto& row : bitMatrix) {
         std::fill(row.begin(), row.end(), false); // Set all bits in each row to false (0)
     }
+    std::fill(rowInfo.begin(), rowInfo.end(), RowInfo());
 
     numInstsInWIB = 0;
+    numColumnsInUse = 0;
+    numWaitingInsts = 0;
 }
 
 std::string
@@ -64,6 +70,81 @@ WIB::name() const
     return cpu->name() + ".wib";
 }
 
+void
+WIB::regProbePoints()
+{
+    ppInsert = new ProbePointArg<DynInstPtr>(
+            cpu->getProbeManager(), "WIBInsert");
+    ppRelease = new ProbePointArg<DynInstPtr>(
+            cpu->getProbeManager(), "WIBRelease");
+    ppSquash = new ProbePointArg<DynInstPtr>(
+            cpu->getProbeManager(), "WIBSquash");
+}
+
+void
+WIB::sampleOccupancy()
+{
+    stats.occupancy.sample(numInstsInWIB);
+    stats.waitingInsts.sample(numWaitingInsts);
+    stats.columnsInUse.sample(numColumnsInUse);
+}
+
+void
+WIB::creditQuiescentCycles(Cycles cycles)
+{
+    stats.occupancy.sample(numInstsInWIB, cycles);
+    stats.waitingInsts.sample(numWaitingInsts, cycles);
+    stats.columnsInUse.sample(numColumnsInUse, cycles);
+}
+
+void
+WIB::setTag(size_t rowIdx, size_t colIdx)
+{
+    if (bitMatrix[rowIdx][colIdx])
+        return;
+
+    bitMatrix[rowIdx][colIdx] = true;
+
+    RowInfo &row = rowInfo[rowIdx];
+    if (row.numTags++ == 0) {
+        ++numWaitingInsts;
+        ++stats.insertions;
+        if (row.numReleases) {
+            ++stats.reinsertions;
+            stats.reinsertionLatency.sample(cpu->curCycle() - row.lastMove);
+        }
+        row.lastMove = cpu->curCycle();
+#if TRACING_ON
+        DynInstPtr &inst = instList[rowIdx];
+        if (inst->wibEnterTick == -1)
+            inst->wibEnterTick = curTick() - inst->fetchTick;
+#endif
+        ppInsert->notify(instList[rowIdx]);
+    }
+}
+
+void
+WIB::clearColumnTags(size_t colIdx)
+{
+    for (size_t rowIdx = 0; rowIdx < bitMatrix.size(); ++rowIdx) {
+        if (bitMatrix[rowIdx][colIdx]) {
+            bitMatrix[rowIdx][colIdx] = false;
+            if (--rowInfo[rowIdx].numTags == 0)
+                --numWaitingInsts;
+        }
+    }
+}
+
+void
+WIB::clearRowTags(size_t rowIdx)
+{
+    std::fill(bitMatrix[rowIdx].begin(), bitMatrix[rowIdx].end(), false);
+    if (rowInfo[rowIdx].numTags) {
+        rowInfo[rowIdx].numTags = 0;
+        --numWaitingInsts;
+    }
+}
+
 void
 WIB::wibEmpty()
 {
@@ -138,11 +219,15 @@ WIB::addColumn(const DynInstPtr &inst)
     }
 
     // if (!found_column) {std::cout << "NO SPACE IN WIB FOR LOAD" << std::endl; }
+    if (found_column) {
+        ++numColumnsInUse;
+        ++stats.columnsAllocated;
+    } else {
+        ++stats.columnAllocFailures;
+    }
 
     // reset column
-    for (auto& row: bitMatrix) {
-        row[colIdx] = false;
-    }
+    clearColumnTags(colIdx);
     
     // return the new column idx for the dependent instructions
     return colIdx;
@@ -153,8 +238,11 @@ WIB::removeColumn(const size_t colIdx)
 {
    //  std::cout << "removing column " << colIdx << std::endl;
     // process the columns rows to send dependendent insts back to issue queue
+    if (loadList[colIdx])
+        --numColumnsInUse;
     loadList[colIdx] = nullptr;
     bool any_dispatched = false;
+    unsigned num_released = 0;
     for (size_t rowIdx = 0; rowIdx < bitMatrix.size(); ++rowIdx) {
         if (bitMatrix[rowIdx][colIdx]) {
             any_dispatched = true;
@@ -166,21 +254,37 @@ WIB::removeColumn(const size_t colIdx)
             instList[rowIdx]->renamedDestIdx(0)->setWaitBit(false);
             wibInsert(instList[rowIdx]);
 
+            RowInfo &row = rowInfo[rowIdx];
+            ++num_released;
+            ++row.numReleases;
+            stats.timeInWIB.sample(cpu->curCycle() - row.lastMove);
+            row.lastMove = cpu->curCycle();
+#if TRACING_ON
+            instList[rowIdx]->wibExitTick =
+                curTick() - instList[rowIdx]->fetchTick;
+#endif
+            ppRelease->notify(instList[rowIdx]);
+
             // clear other columns for the current instructionn and send it back to IQ
             // if it still has dependence on another load at that point, it will come back into WIB
-            std::fill(bitMatrix[rowIdx].begin(), bitMatrix[rowIdx].end(), false);
+            clearRowTags(rowIdx);
         }
-    }}
+    }
+    stats.releasedPerColumn.sample(num_released);
+}
 
 void
 WIB::squashColumn(const size_t colIdx)
 {
     // std::cout << "squashing column " << colIdx << std::endl;
     // colIdx -> entryIdx
-    loadList[colIdx] = nullptr;
-    for (auto& row : bitMatrix) {
-        row[colIdx] = false;
+    if (loadList[colIdx]) {
+        --numColumnsInUse;
+        ++stats.squashedColumns;
+        ppSquash->notify(loadList[colIdx]);
     }
+    loadList[colIdx] = nullptr;
+    clearColumnTags(colIdx);
 }
 
 void
@@ -204,8 +308,13 @@ WIB::squashRow(const size_t rowIdx)
         // inst->renamedDestIdx(0)->setWaitBit(false);
     // }
 
+    if (inst && rowInfo[rowIdx].numTags) {
+        ++stats.squashedInsts;
+        ppSquash->notify(inst);
+    }
+
     instList[rowIdx] = nullptr;
-    std::fill(bitMatrix[rowIdx].begin(), bitMatrix[rowIdx].end(), false);
+    clearRowTags(rowIdx);
 }
 
 void
@@ -215,6 +324,7 @@ WIB::insertInst(const DynInstPtr &inst)
 
     tailInst = (tailInst + 1) % numEntries;
     instList[tailInst] = inst;
+    rowInfo[tailInst].numReleases = 0;
 
     ++numInstsInWIB;
 }
@@ -247,7 +357,7 @@ WIB::tagDependentInst(const DynInstPtr &inst, const size_t colIdx) {
             found = true;
             // std::cout << "writing 1 to col " << colIdx << " for current instruction" << std::endl;
             // std::cout << "Accessing bitMatrix[" << i << "][" << colIdx << "]" << std::endl;
-            bitMatrix[i][colIdx] = true;  // Suspected line
+            setTag(i, colIdx);
             // std::cout << "Value set successfully at bitMatrix[" << i << "][" << colIdx << "]" << std::endl;
             break;
         }
@@ -293,6 +403,7 @@ WIB::squash(InstSeqNum squash_num)
 {
     written_since_squash = 0;
     doneSquashing = false;
+    ++stats.squashes;
     if (numInstsInWIB != 0) {
         doSquash(squash_num);
     }
@@ -311,5 +422,55 @@ WIB::retireHead()
     --numInstsInWIB;
 }
 
+WIB::WIBStats::WIBStats(statistics::Group *parent, unsigned num_entries,
+                        unsigned num_loads)
+  : statistics::Group(parent, "wib"),
+    ADD_STAT(occupancy, statistics::units::Count::get(),
+        "Number of WIB entries in use each cycle"),
+    ADD_STAT(waitingInsts, statistics::units::Count::get(),
+        "Number of insts waiting on a load miss in the WIB each cycle"),
+    ADD_STAT(columnsInUse, statistics::units::Count::get(),
+        "Number of load miss columns in use each cycle"),
+    ADD_STAT(columnsAllocated, statistics::units::Count::get(),
+        "Number of load misses allocated a column"),
+    ADD_STAT(columnAllocFailures, statistics::units::Count::get(),
+        "Number of load misses that found no free column"),
+    ADD_STAT(insertions, statistics::units::Count::get(),
+        "Number of insts moved into the WIB"),
+    ADD_STAT(reinsertions, statistics::units::Count::get(),
+        "Number of insts moved into the WIB again after being released"),
+    ADD_STAT(reinsertionLatency, statistics::units::Cycle::get(),
+        "Cycles between the release of an inst and its reinsertion"),
+    ADD_STAT(releasedPerColumn, statistics::units::Count::get(),
+        "Number of insts released when a load miss completes"),
+    ADD_STAT(timeInWIB, statistics::units::Cycle::get(),
+        "Cycles spent waiting in the WIB by the released insts"),
+    ADD_STAT(squashes, statistics::units::Count::get(),
+        "Number of WIB squashes"),
+    ADD_STAT(squashedInsts, statistics::units::Count::get(),
+        "Number of squashed insts that were waiting in the WIB"),
+    ADD_STAT(squashedColumns, statistics::units::Count::get(),
+        "Number of squashed load miss columns")
+{
+    occupancy
+        .init(0, num_entries, std::max(1U, num_entries / 16))
+        .flags(statistics::pdf);
+    waitingInsts
+        .init(0, num_entries, std::max(1U, num_entries / 16))
+        .flags(statistics::pdf);
+    columnsInUse
+        .init(0, num_loads, std::max(1U, num_loads / 16))
+        .flags(statistics::pdf);
+    reinsertionLatency
+        .init(0, 299, 10)
+        .flags(statistics::nozero);
+    releasedPerColumn
+        .init(0, num_entries, std::max(1U, num_entries / 16))
+        .flags(statistics::pdf);
+    timeInWIB
+        .init(0, 299, 10)
+        .flags(statistics::nozero);
+}
+
 } // namespace o3
 } // namespace gem5
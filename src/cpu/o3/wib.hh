@@ -12,6 +12,7 @@
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/reg_class.hh"
+#include "sim/probe/probe.hh"
 
 namespace gem5
 {
@@ -40,6 +41,15 @@ class WIB
 
     std::string name() const;
 
+    /** Registers probes. */
+    void regProbePoints();
+
+    /** Samples the occupancy stats, once per cycle. */
+    void sampleOccupancy();
+
+    /** Samples the occupancy stats of cycles skipped while quiescent. */
+    void creditQuiescentCycles(Cycles cycles);
+
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
 
@@ -131,15 +141,72 @@ class WIB
     /** Is the WIB done squashing. */
     bool doneSquashing;
 
-    // struct WIBStats : public statistics::Group
-    // {
-    //     WIBStats(statistics::Group *parent);
-    //
-    //     // The number of wib_reads
-    //     statistics::Scalar reads;
-    //     // The number of wib_writes
-    //     statistics::Scalar writes;
-    // } stats;
+    /** Number of load miss columns holding a load. */
+    unsigned numColumnsInUse;
+
+    /** Number of rows with at least one column bit set. */
+    unsigned numWaitingInsts;
+
+    /** Per row bookkeeping, indexed like instList. */
+    struct RowInfo
+    {
+        /** Number of column bits set in the row. */
+        unsigned numTags = 0;
+        /** Number of times the instruction was released to the IQ. */
+        unsigned numReleases = 0;
+        /** Cycle the instruction was last moved into or out of the WIB. */
+        Cycles lastMove = Cycles(0);
+    };
+    std::vector<RowInfo> rowInfo;
+
+    /** Sets a column bit of a row, updating the row bookkeeping. */
+    void setTag(size_t rowIdx, size_t colIdx);
+
+    /** Clears a column bit of every row. */
+    void clearColumnTags(size_t colIdx);
+
+    /** Clears every column bit of a row. */
+    void clearRowTags(size_t rowIdx);
+
+    struct WIBStats : public statistics::Group
+    {
+        WIBStats(statistics::Group *parent, unsigned num_entries,
+                 unsigned num_loads);
+
+        /** Distribution of the number of WIB entries in use. */
+        statistics::Distribution occupancy;
+        /** Distribution of the number of insts waiting on load misses. */
+        statistics::Distribution waitingInsts;
+        /** Distribution of the number of load miss columns in use. */
+        statistics::Distribution columnsInUse;
+        /** Number of load misses allocated a column. */
+        statistics::Scalar columnsAllocated;
+        /** Number of load misses that found no free column. */
+        statistics::Scalar columnAllocFailures;
+        /** Number of insts moved into the WIB. */
+        statistics::Scalar insertions;
+        /** Number of insts moved into the WIB after being released. */
+        statistics::Scalar reinsertions;
+        /** Cycles between the release of an inst and its reinsertion. */
+        statistics::Distribution reinsertionLatency;
+        /** Number of insts released when a load miss completes. */
+        statistics::Distribution releasedPerColumn;
+        /** Cycles spent in the WIB by the released insts. */
+        statistics::Distribution timeInWIB;
+        /** Number of WIB squashes. */
+        statistics::Scalar squashes;
+        /** Number of squashed insts that were waiting in the WIB. */
+        statistics::Scalar squashedInsts;
+        /** Number of squashed load miss columns. */
+        statistics::Scalar squashedColumns;
+    } stats;
+
+    /** Probe points notified with the inst moved into the WIB, released
+     *  to the IQ, or squashed while in the WIB. Squashed load misses are
+     *  notified when their column is squashed. */
+    ProbePointArg<DynInstPtr> *ppInsert;
+    ProbePointArg<DynInstPtr> *ppRelease;
+    ProbePointArg<DynInstPtr> *ppSquash;
 
   public:
     //columns for each load cache miss instruction
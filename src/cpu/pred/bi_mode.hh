@@ -47,6 +47,7 @@
 
 #include "base/sat_counter.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/history_pool.hh"
 #include "params/BiModeBP.hh"
 
 namespace gem5
@@ -85,7 +86,7 @@ class BiModeBP : public BPredUnit
     void updateGlobalHistReg(ThreadID tid, bool taken);
     void uncondBranch(ThreadID tid, Addr pc, void * &bp_history);
 
-    struct BPHistory
+    struct BPHistory : public PooledHistory
     {
         unsigned globalHistoryReg;
         // was the taken array's prediction used?
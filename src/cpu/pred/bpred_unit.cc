@@ -99,15 +99,13 @@ bool
 BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
                    PCStateBase &pc, ThreadID tid)
 {
+    /** Get a record at the front of the history buffer */
+    PredictorHistory* bpu_history = predHist[tid].push_front();
+    bpu_history->init(tid, seqNum, pc.instAddr(), inst);
+
     /** Perform the prediction. */
-    PredictorHistory* bpu_history = nullptr;
     bool taken  = predict(inst, seqNum, pc, tid, bpu_history);
 
-    assert(bpu_history!=nullptr);
-
-    /** Push the record into the history buffer */
-    predHist[tid].push_front(bpu_history);
-
     DPRINTF(Branch, "[tid:%i] [sn:%llu] History entry added. "
             "predHist.size(): %i\n", tid, seqNum, predHist[tid].size());
 
@@ -119,9 +117,9 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
 
 bool
 BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
-                   PCStateBase &pc, ThreadID tid, PredictorHistory* &hist)
+                   PCStateBase &pc, ThreadID tid, PredictorHistory* hist)
 {
-    assert(hist == nullptr);
+    assert(hist != nullptr);
 
 
     // See if branch predictor predicts taken.
@@ -129,8 +127,7 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     // Save off branch stuff into `hist` so we can correct the predictor
     // if prediction was wrong.
 
-    BranchType brType = getBranchType(inst);
-    hist = new PredictorHistory(tid, seqNum, pc.instAddr(), inst);
+    BranchType brType = hist->type;
 
     stats.lookups[tid][brType]++;
     ppBranches->notify(1);
@@ -342,9 +339,9 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
 
         // Iterate from the back to front. Least recent
         // sequence number until the most recent done number
-        commitBranch(tid, *predHist[tid].rbegin());
+        PredictorHistory *hist = predHist[tid].back();
+        commitBranch(tid, hist);
 
-        delete predHist[tid].back();
         predHist[tid].pop_back();
         DPRINTF(Branch, "[tid:%i] [commit sn:%llu] pred_hist.size(): %i\n",
                 tid, done_sn, predHist[tid].size());
@@ -404,8 +401,6 @@ BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
                 "sn:%llu, PC:%#x\n", tid, squashed_sn, hist->seqNum,
                 hist->pc);
 
-
-        delete predHist[tid].front();
         predHist[tid].pop_front();
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] pred_hist.size(): %i\n",
@@ -611,17 +606,15 @@ BPredUnit::dump()
     int i = 0;
     for (const auto& ph : predHist) {
         if (!ph.empty()) {
-            auto hist = ph.begin();
-
             cprintf("predHist[%i].size(): %i\n", i++, ph.size());
 
-            while (hist != ph.end()) {
+            for (size_t idx = 0; idx < ph.size(); idx++) {
+                const PredictorHistory *hist = ph[idx];
                 cprintf("sn:%llu], PC:%#x, tid:%i, predTaken:%i, "
                         "bpHistory:%#x, rasHistory:%#x\n",
-                        (*hist)->seqNum, (*hist)->pc,
-                        (*hist)->tid, (*hist)->predTaken,
-                        (*hist)->bpHistory, (*hist)->rasHistory);
-                hist++;
+                        hist->seqNum, hist->pc,
+                        hist->tid, hist->predTaken,
+                        hist->bpHistory, hist->rasHistory);
             }
 
             cprintf("\n");
@@ -630,6 +623,22 @@ BPredUnit::dump()
 }
 
 
+BPredUnit::History::History()
+{
+    // Enough for most windows, grown on demand
+    ring.reserve(64);
+}
+
+BPredUnit::PredictorHistory *
+BPredUnit::History::push_front()
+{
+    auto &slot = ring.push_front();
+    if (!slot)
+        slot = std::make_unique<PredictorHistory>();
+    return slot.get();
+}
+
+
 BPredUnit::BPredUnitStats::BPredUnitStats(BPredUnit *bp)
     : statistics::Group(bp),
       ADD_STAT(lookups, statistics::units::Count::get(),
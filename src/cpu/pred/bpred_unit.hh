@@ -42,10 +42,12 @@
 #ifndef __CPU_PRED_BPRED_UNIT_HH__
 #define __CPU_PRED_BPRED_UNIT_HH__
 
-#include <deque>
+#include <memory>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "cpu/history_ring.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/pred/branch_type.hh"
 #include "cpu/pred/btb.hh"
@@ -247,27 +249,36 @@ class BPredUnit : public SimObject
   private:
     struct PredictorHistory
     {
+        PredictorHistory() = default;
+
         /**
-         * Makes a predictor history struct that contains any
+         * Sets up a predictor history struct, which is recycled from a
+         * branch that already committed or squashed, to contain any
          * information needed to update the predictor, BTB, and RAS.
+         * The target is kept allocated, to be updated in place.
          */
-        PredictorHistory(ThreadID _tid, InstSeqNum sn, Addr _pc,
-                         const StaticInstPtr & inst)
-            : seqNum(sn), tid(_tid), pc(_pc),
-              inst(inst), type(getBranchType(inst)),
-              call(inst->isCall()), uncond(inst->isUncondCtrl()),
-              predTaken(false), actuallyTaken(false), condPred(false),
-              btbHit(false), targetProvider(TargetProvider::NoTarget),
-              resteered(false), mispredict(false), target(nullptr),
-              bpHistory(nullptr),
-              indirectHistory(nullptr), rasHistory(nullptr)
-        { }
-
-        ~PredictorHistory()
+        void
+        init(ThreadID _tid, InstSeqNum sn, Addr _pc,
+             const StaticInstPtr &_inst)
         {
             assert(bpHistory == nullptr);
             assert(indirectHistory == nullptr);
             assert(rasHistory == nullptr);
+
+            seqNum = sn;
+            tid = _tid;
+            pc = _pc;
+            inst = _inst;
+            type = getBranchType(_inst);
+            call = _inst->isCall();
+            uncond = _inst->isUncondCtrl();
+            predTaken = false;
+            actuallyTaken = false;
+            condPred = false;
+            btbHit = false;
+            targetProvider = TargetProvider::NoTarget;
+            resteered = false;
+            mispredict = false;
         }
 
         PredictorHistory (const PredictorHistory&) = delete;
@@ -280,46 +291,46 @@ class BPredUnit : public SimObject
         }
 
         /** The sequence number for the predictor history entry. */
-        const InstSeqNum seqNum;
+        InstSeqNum seqNum = 0;
 
         /** The thread id. */
-        const ThreadID tid;
+        ThreadID tid = 0;
 
         /** The PC associated with the sequence number. */
-        const Addr pc;
+        Addr pc = 0;
 
         /** The branch instrction */
-        const StaticInstPtr inst;
+        StaticInstPtr inst;
 
         /** The type of the branch */
-        const BranchType type;
+        BranchType type = BranchType::NoBranch;
 
         /** Whether or not the instruction was a call. */
-        const bool call;
+        bool call = false;
 
         /** Was unconditional control */
-        const bool uncond;
+        bool uncond = false;
 
         /** Whether or not it was predicted taken. */
-        bool predTaken;
+        bool predTaken = false;
 
         /** To record the actual outcome of the branch */
-        bool actuallyTaken;
+        bool actuallyTaken = false;
 
         /** The prediction of the conditional predictor */
-        bool condPred;
+        bool condPred = false;
 
         /** Was BTB hit at prediction time */
-        bool btbHit;
+        bool btbHit = false;
 
         /** Which component provided the target */
-        TargetProvider targetProvider;
+        TargetProvider targetProvider = TargetProvider::NoTarget;
 
         /** Resteered */
-        bool resteered;
+        bool resteered = false;
 
         /** The branch was corrected hence was mispredicted. */
-        bool mispredict;
+        bool mispredict = false;
 
         /** The predicted target */
         std::unique_ptr<PCStateBase> target;
@@ -338,14 +349,60 @@ class BPredUnit : public SimObject
 
     };
 
-    typedef std::deque<PredictorHistory*> History;
+    /**
+     * The predictor histories of a thread, from the youngest branch at the
+     * front to the oldest one at the back. The records are allocated the
+     * first time their slot of the ring is used and recycled afterwards, so
+     * predicting a branch does not allocate once the ring is large enough.
+     * The ring holds pointers, so that a record does not move when the
+     * ring grows while branches in flight point to it.
+     */
+    class History
+    {
+      private:
+        HistoryRing<std::unique_ptr<PredictorHistory>> ring;
+
+      public:
+        History();
+
+        bool empty() const { return ring.empty(); }
+        size_t size() const { return ring.size(); }
+
+        /** The youngest record. */
+        PredictorHistory *front() const { return ring.front().get(); }
+
+        /** The oldest record. */
+        PredictorHistory *back() const { return ring.back().get(); }
+
+        /**
+         * The idx-th youngest record.
+         * @param idx 0 for the youngest record.
+         */
+        PredictorHistory *
+        operator[](size_t idx) const
+        {
+            return ring[idx].get();
+        }
+
+        /**
+         * Makes a record the youngest one. The caller must initialise it.
+         * @return The record, which may have been used by an older branch.
+         */
+        PredictorHistory *push_front();
+
+        /** Drops the youngest record. */
+        void pop_front() { ring.pop_front(); }
+
+        /** Drops the oldest record. */
+        void pop_back() { ring.pop_back(); }
+    };
 
 
     /**
      * Internal prediction function.
     */
     bool predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
-               PCStateBase &pc, ThreadID tid, PredictorHistory* &bpu_history);
+               PCStateBase &pc, ThreadID tid, PredictorHistory* bpu_history);
 
     /**
      * Squashes a particular branch instance
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the history record allocator.
+ */
+
+#include "cpu/pred/history_pool.hh"
+
+#include <array>
+#include <new>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/** Granularity of the size classes. */
+constexpr std::size_t granularity = alignof(std::max_align_t);
+
+/** Number of size classes, records up to 2KiB are recycled. */
+constexpr std::size_t numClasses = 2048 / granularity;
+
+/** A free block, linked through its first bytes. */
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+/** Free lists of the size classes, the size class 0 is unused. */
+thread_local std::array<FreeBlock *, numClasses + 1> freeLists{};
+
+std::size_t
+sizeClass(std::size_t size)
+{
+    return (size + granularity - 1) / granularity;
+}
+
+} // anonymous namespace
+
+void *
+allocHistory(std::size_t size)
+{
+    const std::size_t cls = sizeClass(size);
+    if (cls > numClasses || cls == 0)
+        return ::operator new(size);
+
+    FreeBlock *block = freeLists[cls];
+    if (!block)
+        return ::operator new(cls * granularity);
+
+    freeLists[cls] = block->next;
+    return block;
+}
+
+void
+freeHistory(void *ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    const std::size_t cls = sizeClass(size);
+    if (cls > numClasses || cls == 0) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = freeLists[cls];
+    freeLists[cls] = block;
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Recycling allocator for the per-branch history records of the branch
+ * predictors.
+ */
+
+#ifndef __CPU_PRED_HISTORY_POOL_HH__
+#define __CPU_PRED_HISTORY_POOL_HH__
+
+#include <cstddef>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * Allocates a block for a history record. Blocks are recycled through a
+ * free list per size class, so in the steady state, where records are
+ * freed at the same rate as they are allocated, no call goes to the heap
+ * allocator. Blocks larger than the biggest size class are allocated on
+ * the heap. The free lists are per host thread.
+ *
+ * @param size Size of the block in bytes.
+ * @return A block aligned for any scalar type.
+ */
+void *allocHistory(std::size_t size);
+
+/**
+ * Returns a block allocated by allocHistory() to its free list.
+ *
+ * @param ptr The block, may be nullptr.
+ * @param size The size the block was allocated with.
+ */
+void freeHistory(void *ptr, std::size_t size);
+
+/**
+ * Base class of the history records the predictors allocate for each
+ * predicted branch and free on commit or squash. It only provides a class
+ * specific operator new and delete using allocHistory(), so records keep
+ * being created with new and destroyed with delete.
+ */
+struct PooledHistory
+{
+    static void *
+    operator new(std::size_t size)
+    {
+        return allocHistory(size);
+    }
+
+    static void
+    operator delete(void *ptr, std::size_t size)
+    {
+        freeHistory(ptr, size);
+    }
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_HISTORY_POOL_HH__
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "cpu/pred/history_pool.hh"
+
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+struct Record : public PooledHistory
+{
+    uint64_t data[3];
+};
+
+struct BaseRecord : public PooledHistory
+{
+    virtual ~BaseRecord() = default;
+};
+
+struct BigRecord : public BaseRecord
+{
+    char data[200];
+};
+
+} // anonymous namespace
+
+/** A freed block is handed out again for the same size class */
+TEST(HistoryPoolTest, Recycles)
+{
+    void *first = allocHistory(24);
+    freeHistory(first, 24);
+    EXPECT_EQ(allocHistory(20), first);
+    freeHistory(first, 20);
+}
+
+/** Blocks of different size classes are not mixed */
+TEST(HistoryPoolTest, SizeClasses)
+{
+    void *small = allocHistory(16);
+    freeHistory(small, 16);
+    void *large = allocHistory(256);
+    EXPECT_NE(large, small);
+    freeHistory(large, 256);
+    EXPECT_EQ(allocHistory(16), small);
+    freeHistory(small, 16);
+}
+
+/** Blocks are usable for their whole size, including huge ones */
+TEST(HistoryPoolTest, Usable)
+{
+    for (size_t size : {1, 8, 100, 2048, 100000}) {
+        char *block = static_cast<char *>(allocHistory(size));
+        std::memset(block, 0xa5, size);
+        EXPECT_EQ(block[size - 1], char(0xa5));
+        freeHistory(block, size);
+    }
+    freeHistory(nullptr, 8);
+}
+
+/** Records deleted through a base pointer go to their own size class */
+TEST(HistoryPoolTest, PooledRecords)
+{
+    Record *record = new Record;
+    delete record;
+    Record *other = new Record;
+    EXPECT_EQ(other, record);
+    delete other;
+
+    BaseRecord *big = new BigRecord;
+    delete big;
+    EXPECT_EQ(allocHistory(sizeof(BigRecord)), big);
+    freeHistory(big, sizeof(BigRecord));
+}
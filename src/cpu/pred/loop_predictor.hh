@@ -46,6 +46,7 @@
 
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "cpu/pred/history_pool.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -137,7 +138,7 @@ class LoopPredictor : public SimObject
     }
   public:
     // Primary branch history entry
-    struct BranchInfo
+    struct BranchInfo : public PooledHistory
     {
         uint16_t loopTag;
         uint16_t currentIter;
@@ -55,6 +55,7 @@
 #include <vector>
 
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/history_pool.hh"
 #include "params/MultiperspectivePerceptron.hh"
 
 namespace gem5
@@ -69,7 +70,7 @@ class MultiperspectivePerceptron : public BPredUnit
     /**
      * Branch information data
      */
-    class MPPBranchInfo
+    class MPPBranchInfo : public PooledHistory
     {
         /** pc of the branch */
         const unsigned int pc;
@@ -47,6 +47,7 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/pred/branch_type.hh"
+#include "cpu/pred/history_pool.hh"
 #include "cpu/static_inst.hh"
 #include "params/ReturnAddrStack.hh"
 #include "sim/sim_object.hh"
@@ -181,7 +182,7 @@ class ReturnAddrStack : public SimObject
 
   private:
 
-    class RASHistory
+    class RASHistory : public PooledHistory
     {
       public:
         /* Was the RAS pushed or poped for this branch. */
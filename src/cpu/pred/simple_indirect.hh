@@ -43,6 +43,7 @@
 
 #include "base/statistics.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/pred/history_pool.hh"
 #include "cpu/pred/indirect.hh"
 #include "params/SimpleIndirectPredictor.hh"
 
@@ -109,7 +110,7 @@ class SimpleIndirectPredictor : public IndirectPredictor
     /** Indirect branch history information
      * Used for prediction, update and recovery
      */
-    struct IndirectHistory
+    struct IndirectHistory : public PooledHistory
     {
         /* data */
         Addr pcAddr;
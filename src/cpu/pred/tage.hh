@@ -78,7 +78,7 @@ class TAGE: public BPredUnit
   protected:
     TAGEBase *tage;
 
-    struct TageBranchInfo
+    struct TageBranchInfo : public PooledHistory
     {
         TAGEBase::BranchInfo *tageBranchInfo;
 
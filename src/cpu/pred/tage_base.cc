@@ -127,9 +127,9 @@ TAGEBase::init()
     assert(tagTableTagWidths[0] == 0);
 
     for (auto& history : threadHistory) {
-        history.computeIndices = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[0] = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[1] = new FoldedHistory[nHistoryTables+1];
+        history.computeIndices.resize(nHistoryTables+1);
+        history.computeTags[0].resize(nHistoryTables+1);
+        history.computeTags[1].resize(nHistoryTables+1);
 
         initFoldedHistories(history);
     }
@@ -144,6 +144,10 @@ TAGEBase::init()
 
     tableIndices = new int [nHistoryTables+1];
     tableTags = new int [nHistoryTables+1];
+
+    bankHashes.init(nHistoryTables, logTagTableSizes.data(),
+                    tagTableTagWidths.data(), histLengths, pathHistBits);
+
     initialized = true;
 }
 
@@ -192,14 +196,10 @@ TAGEBase::btbUpdate(ThreadID tid, Addr branch_pc, BranchInfo* &bi)
         DPRINTF(Tage, "BTB miss resets prediction: %lx\n", branch_pc);
         assert(tHist.gHist == &tHist.globalHistory[tHist.ptGhist]);
         tHist.gHist[0] = 0;
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].comp = bi->ci[i];
-            tHist.computeTags[0][i].comp = bi->ct0[i];
-            tHist.computeTags[1][i].comp = bi->ct1[i];
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.computeIndices.restore(bi->ci);
+        tHist.computeTags[0].restore(bi->ct0);
+        tHist.computeTags[1].restore(bi->ct1);
+        updateFoldedHistories(tHist);
     }
 }
 
@@ -336,15 +336,28 @@ TAGEBase::updateGHist(uint8_t * &h, bool dir, uint8_t * tab, int &pt)
     h[0] = (dir) ? 1 : 0;
 }
 
+void
+TAGEBase::updateFoldedHistories(ThreadHistory & history)
+{
+    history.computeIndices.update(history.gHist);
+    history.computeTags[0].update(history.gHist);
+    history.computeTags[1].update(history.gHist);
+}
+
 void
 TAGEBase::calculateIndicesAndTags(ThreadID tid, Addr branch_pc,
                                   BranchInfo* bi)
 {
-    // computes the table addresses and the partial tags
+    // computes the table addresses and the partial tags, with the same
+    // hashes as gindex() and gtag() but for all the banks in one loop
+    const ThreadHistory &tHist = threadHistory[tid];
+    bankHashes.compute(branch_pc >> instShiftAmt, tHist.pathHist,
+                       tHist.computeIndices.compData(),
+                       tHist.computeTags[0].compData(),
+                       tHist.computeTags[1].compData(),
+                       tableIndices, tableTags);
     for (int i = 1; i <= nHistoryTables; i++) {
-        tableIndices[i] = gindex(tid, branch_pc, i);
         bi->tableIndices[i] = tableIndices[i];
-        tableTags[i] = gtag(tid, branch_pc, i);
         bi->tableTags[i] = tableTags[i];
     }
 }
@@ -607,17 +620,12 @@ TAGEBase::updateHistories(ThreadID tid, Addr branch_pc, bool taken,
     }
 
     //prepare next index and tag computations for user branchs
-    for (int i = 1; i <= nHistoryTables; i++)
-    {
-        if (speculative) {
-            bi->ci[i]  = tHist.computeIndices[i].comp;
-            bi->ct0[i] = tHist.computeTags[0][i].comp;
-            bi->ct1[i] = tHist.computeTags[1][i].comp;
-        }
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
+    if (speculative) {
+        tHist.computeIndices.save(bi->ci);
+        tHist.computeTags[0].save(bi->ct0);
+        tHist.computeTags[1].save(bi->ct1);
     }
+    updateFoldedHistories(tHist);
     DPRINTF(Tage, "Updating global histories with branch:%lx; taken?:%d, "
             "path Hist: %x; pointer:%d\n", branch_pc, taken, tHist.pathHist,
             tHist.ptGhist);
@@ -641,14 +649,10 @@ TAGEBase::squash(ThreadID tid, bool taken, TAGEBase::BranchInfo *bi,
     tHist.ptGhist = bi->ptGhist;
     tHist.gHist = &(tHist.globalHistory[tHist.ptGhist]);
     tHist.gHist[0] = (taken ? 1 : 0);
-    for (int i = 1; i <= nHistoryTables; i++) {
-        tHist.computeIndices[i].comp = bi->ci[i];
-        tHist.computeTags[0][i].comp = bi->ct0[i];
-        tHist.computeTags[1][i].comp = bi->ct1[i];
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
-    }
+    tHist.computeIndices.restore(bi->ci);
+    tHist.computeTags[0].restore(bi->ct0);
+    tHist.computeTags[1].restore(bi->ct1);
+    updateFoldedHistories(tHist);
 }
 
 void
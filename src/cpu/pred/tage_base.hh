@@ -52,6 +52,8 @@
 
 #include "base/statistics.hh"
 #include "cpu/null_static_inst.hh"
+#include "cpu/pred/history_pool.hh"
+#include "cpu/pred/tage_hash.hh"
 #include "cpu/static_inst.hh"
 #include "params/TAGEBase.hh"
 #include "sim/sim_object.hh"
@@ -80,35 +82,113 @@ class TAGEBase : public SimObject
         TageEntry() : ctr(0), tag(0), u(0) { }
     };
 
-    // Folded History Table - compressed history
+    // Folded History Tables - compressed history
     // to mix with instruction PC to index partially
-    // tagged tables.
-    struct FoldedHistory
+    // tagged tables. The folded histories of all the
+    // banks are stored as one array per field, so that
+    // updating, saving and restoring them all are
+    // simple loops the compiler can vectorize.
+    class FoldedHistories
     {
-        unsigned comp;
-        int compLength;
-        int origLength;
-        int outpoint;
-        int bufferSize;
+      private:
+        std::vector<unsigned> comps;
+        std::vector<int> compLengths;
+        std::vector<int> origLengths;
+        std::vector<int> outpoints;
+        std::vector<unsigned> masks;
+
+      public:
+        // Folded history of a single bank
+        struct Ref
+        {
+            unsigned &comp;
+            int &compLength;
+            int &origLength;
+            int &outpoint;
+            unsigned &mask;
+
+            void init(int original_length, int compressed_length)
+            {
+                origLength = original_length;
+                compLength = compressed_length;
+                outpoint = original_length % compressed_length;
+                mask = (1ULL << compLength) - 1;
+            }
+
+            void update(const uint8_t * h)
+            {
+                comp = (comp << 1) | h[0];
+                comp ^= h[origLength] << outpoint;
+                comp ^= (comp >> compLength);
+                comp &= mask;
+            }
+        };
+
+        // Read-only folded history of a single bank
+        struct ConstRef
+        {
+            const unsigned &comp;
+            const int &compLength;
+            const int &origLength;
+            const int &outpoint;
+        };
+
+        void
+        resize(int num_banks)
+        {
+            comps.assign(num_banks, 0);
+            compLengths.assign(num_banks, 0);
+            origLengths.assign(num_banks, 0);
+            outpoints.assign(num_banks, 0);
+            masks.assign(num_banks, 0);
+        }
 
-        FoldedHistory()
+        Ref
+        operator[](int bank)
         {
-            comp = 0;
+            return Ref{comps[bank], compLengths[bank], origLengths[bank],
+                       outpoints[bank], masks[bank]};
         }
 
-        void init(int original_length, int compressed_length)
+        ConstRef
+        operator[](int bank) const
+        {
+            return ConstRef{comps[bank], compLengths[bank], origLengths[bank],
+                            outpoints[bank]};
+        }
+
+        const unsigned *compData() const { return comps.data(); }
+
+        // Updates the banks 1 to N with the new history h
+        void
+        update(const uint8_t * h)
         {
-            origLength = original_length;
-            compLength = compressed_length;
-            outpoint = original_length % compressed_length;
+            const int n = comps.size();
+            unsigned *comp = comps.data();
+            for (int i = 1; i < n; i++) {
+                unsigned c = (comp[i] << 1) | h[0];
+                c ^= h[origLengths[i]] << outpoints[i];
+                c ^= (c >> compLengths[i]);
+                comp[i] = c & masks[i];
+            }
         }
 
-        void update(uint8_t * h)
+        // Saves the banks 1 to N to dst[1 .. N]
+        void
+        save(int * dst) const
         {
-            comp = (comp << 1) | h[0];
-            comp ^= h[origLength] << outpoint;
-            comp ^= (comp >> compLength);
-            comp &= (1ULL << compLength) - 1;
+            const int n = comps.size();
+            for (int i = 1; i < n; i++)
+                dst[i] = comps[i];
+        }
+
+        // Restores the banks 1 to N from src[1 .. N]
+        void
+        restore(const int * src)
+        {
+            const int n = comps.size();
+            for (int i = 1; i < n; i++)
+                comps[i] = src[i];
         }
     };
 
@@ -125,7 +205,7 @@ class TAGEBase : public SimObject
     };
 
     // Primary branch history entry
-    struct BranchInfo
+    struct BranchInfo : public PooledHistory
     {
         int pathHist;
         int ptGhist;
@@ -144,8 +224,10 @@ class TAGEBase : public SimObject
 
         // Pointer to dynamically allocated storage
         // to save table indices and folded histories.
-        // To do one call to new instead of five.
+        // To do one allocation instead of five, which
+        // is recycled with the branch info.
         int *storage;
+        size_t storageSize;
 
         // Pointers to actual saved array within the dynamically
         // allocated storage.
@@ -169,7 +251,8 @@ class TAGEBase : public SimObject
               provider(-1)
         {
             int sz = tage.nHistoryTables + 1;
-            storage = new int [sz * 5];
+            storageSize = sz * 5 * sizeof(int);
+            storage = static_cast<int *>(allocHistory(storageSize));
             tableIndices = storage;
             tableTags = storage + sz;
             ci = tableTags + sz;
@@ -179,7 +262,7 @@ class TAGEBase : public SimObject
 
         virtual ~BranchInfo()
         {
-            delete[] storage;
+            freeHistory(storage, storageSize);
         }
     };
 
@@ -200,6 +283,13 @@ class TAGEBase : public SimObject
      * @param pc The unshifted branch PC.
      * @param bank The partially tagged table to access.
      */
+    /**
+     * Computes the index of a branch in a tagged table.
+     * The base calculateIndicesAndTags() computes the same
+     * hash for all the banks at once, so a derived class
+     * changing gindex(), F() or gtag() must also override
+     * calculateIndicesAndTags().
+     */
     virtual int gindex(ThreadID tid, Addr pc, int bank) const;
 
     /**
@@ -433,8 +523,9 @@ class TAGEBase : public SimObject
     std::vector<unsigned> tagTableTagWidths;
     std::vector<int> logTagTableSizes;
 
-    std::vector<bool> btablePrediction;
-    std::vector<bool> btableHysteresis;
+    // One byte per bit, to avoid the masking of std::vector<bool>
+    std::vector<uint8_t> btablePrediction;
+    std::vector<uint8_t> btableHysteresis;
     TageEntry **gtable;
 
     // Keep per-thread histories to
@@ -457,8 +548,8 @@ class TAGEBase : public SimObject
         int ptGhist;
 
         // Speculative folded histories.
-        FoldedHistory *computeIndices;
-        FoldedHistory *computeTags[2];
+        FoldedHistories computeIndices;
+        FoldedHistories computeTags[2];
     };
 
     std::vector<ThreadHistory> threadHistory;
@@ -468,10 +559,17 @@ class TAGEBase : public SimObject
      */
     virtual void initFoldedHistories(ThreadHistory & history);
 
+    // Updates the folded histories of a thread for its last outcome
+    void updateFoldedHistories(ThreadHistory & history);
+
     int *histLengths;
     int *tableIndices;
     int *tableTags;
 
+    // gindex() and gtag() of all the banks at once, used by
+    // calculateIndicesAndTags()
+    TAGEBankHashes bankHashes;
+
     std::vector<int8_t> useAltPredForNewlyAllocated;
     int64_t tCounter;
     uint64_t logUResetPeriod;
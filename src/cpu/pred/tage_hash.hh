@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Hashes of the tagged tables of TAGE, computed for all the banks at
+ * once.
+ */
+
+#ifndef __CPU_PRED_TAGE_HASH_HH__
+#define __CPU_PRED_TAGE_HASH_HH__
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * The gindex() and gtag() hashes of TAGEBase, for all the tagged tables
+ * in a single loop. The per bank constants of the hashes are computed
+ * once, and the loop has no virtual calls, so that the compiler can
+ * vectorize it.
+ */
+class TAGEBankHashes
+{
+  private:
+    int numBanks = 0;
+    std::vector<int> logSizes;
+    std::vector<int> indexShifts;
+    std::vector<int> pathHistLengths;
+    std::vector<unsigned> indexMasks;
+    std::vector<unsigned> tagMasks;
+
+  public:
+    /**
+     * @param num_banks Number of tagged tables, numbered from 1.
+     * @param log_sizes Log2 of the number of entries of each table.
+     * @param tag_widths Tag width of each table.
+     * @param hist_lengths History length of each table.
+     * @param path_hist_bits Number of bits of the path history.
+     */
+    void
+    init(int num_banks, const int *log_sizes, const unsigned *tag_widths,
+         const int *hist_lengths, unsigned path_hist_bits)
+    {
+        numBanks = num_banks;
+        logSizes.assign(num_banks + 1, 0);
+        indexShifts.assign(num_banks + 1, 0);
+        pathHistLengths.assign(num_banks + 1, 0);
+        indexMasks.assign(num_banks + 1, 0);
+        tagMasks.assign(num_banks + 1, 0);
+        for (int i = 1; i <= num_banks; i++) {
+            logSizes[i] = log_sizes[i];
+            indexShifts[i] = std::abs(logSizes[i] - i) + 1;
+            pathHistLengths[i] =
+                ((unsigned)hist_lengths[i] > path_hist_bits) ?
+                path_hist_bits : hist_lengths[i];
+            indexMasks[i] = (1ULL << logSizes[i]) - 1;
+            tagMasks[i] = (1ULL << tag_widths[i]) - 1;
+        }
+    }
+
+    /**
+     * Compute the index and tag of a branch in each tagged table.
+     *
+     * @param shifted_pc The PC of the branch, shifted right by the
+     * instruction shift amount.
+     * @param path_hist The path history.
+     * @param ci The folded histories of the indices of each table.
+     * @param ct0 The first folded histories of the tags.
+     * @param ct1 The second folded histories of the tags.
+     * @param indices The index in each table.
+     * @param tags The tag in each table.
+     */
+    void
+    compute(unsigned shifted_pc, int path_hist, const unsigned *ci,
+            const unsigned *ct0, const unsigned *ct1, int *indices,
+            int *tags) const
+    {
+        for (int i = 1; i <= numBanks; i++) {
+            // F() of gindex()
+            const int log_size = logSizes[i];
+            const unsigned size_mask = indexMasks[i];
+            int A = path_hist & ((1ULL << pathHistLengths[i]) - 1);
+            int A1 = A & size_mask;
+            int A2 = A >> log_size;
+            A2 = ((A2 << i) & size_mask) + (A2 >> (log_size - i));
+            A = A1 ^ A2;
+            A = ((A << i) & size_mask) + (A >> (log_size - i));
+
+            const int index = shifted_pc ^ (shifted_pc >> indexShifts[i]) ^
+                ci[i] ^ A;
+            indices[i] = index & size_mask;
+
+            const int tag = shifted_pc ^ ct0[i] ^ (ct1[i] << 1);
+            tags[i] = uint16_t(tag & tagMasks[i]);
+        }
+    }
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_TAGE_HASH_HH__
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/tage_hash.hh"
+
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/** The geometry of the tagged tables of a TAGE predictor. */
+struct Geometry
+{
+    int numBanks;
+    std::vector<int> logSizes;
+    std::vector<unsigned> tagWidths;
+    std::vector<int> histLengths;
+    unsigned pathHistBits;
+
+    Geometry(int num_banks, std::vector<int> log_sizes,
+             std::vector<unsigned> tag_widths, int min_hist, int max_hist,
+             unsigned path_hist_bits)
+      : numBanks(num_banks), logSizes(log_sizes),
+        tagWidths(tag_widths), histLengths(num_banks + 1, 0),
+        pathHistBits(path_hist_bits)
+    {
+        // As in TAGEBase::init()
+        histLengths[1] = min_hist;
+        histLengths[num_banks] = max_hist;
+        for (int i = 2; i <= num_banks; i++) {
+            histLengths[i] = (int)(((double)min_hist *
+                std::pow((double)max_hist / (double)min_hist,
+                         (double)(i - 1) / (double)(num_banks - 1))) + 0.5);
+        }
+    }
+
+    /** TAGEBase::F(), one bank at a time. */
+    int
+    F(int A, int size, int bank) const
+    {
+        int A1, A2;
+
+        A = A & ((1ULL << size) - 1);
+        A1 = (A & ((1ULL << logSizes[bank]) - 1));
+        A2 = (A >> logSizes[bank]);
+        A2 = ((A2 << bank) & ((1ULL << logSizes[bank]) - 1))
+           + (A2 >> (logSizes[bank] - bank));
+        A = A1 ^ A2;
+        A = ((A << bank) & ((1ULL << logSizes[bank]) - 1))
+          + (A >> (logSizes[bank] - bank));
+        return (A);
+    }
+
+    /** TAGEBase::gindex(), one bank at a time. */
+    int
+    gindex(unsigned shifted_pc, int path_hist, unsigned ci, int bank) const
+    {
+        int hlen = ((unsigned)histLengths[bank] > pathHistBits) ?
+            pathHistBits : histLengths[bank];
+        int index =
+            shifted_pc ^
+            (shifted_pc >> ((int)std::abs(logSizes[bank] - bank) + 1)) ^
+            ci ^ F(path_hist, hlen, bank);
+        return (index & ((1ULL << (logSizes[bank])) - 1));
+    }
+
+    /** TAGEBase::gtag(), one bank at a time. */
+    uint16_t
+    gtag(unsigned shifted_pc, unsigned ct0, unsigned ct1, int bank) const
+    {
+        int tag = shifted_pc ^ ct0 ^ (ct1 << 1);
+        return (tag & ((1ULL << tagWidths[bank]) - 1));
+    }
+};
+
+/**
+ * Compare the hashes of all the banks at once with the hashes of each
+ * bank, for random branches and folded histories.
+ */
+void
+compareHashes(const Geometry &g)
+{
+    TAGEBankHashes hashes;
+    hashes.init(g.numBanks, g.logSizes.data(), g.tagWidths.data(),
+                g.histLengths.data(), g.pathHistBits);
+
+    std::mt19937_64 rng(1);
+    const int n = g.numBanks + 1;
+    std::vector<unsigned> ci(n), ct0(n), ct1(n);
+    std::vector<int> indices(n), tags(n);
+
+    for (int branch = 0; branch < 200000; branch++) {
+        const unsigned shifted_pc = rng() >> 2;
+        const int path_hist = rng() & ((1ULL << g.pathHistBits) - 1);
+        for (int i = 1; i <= g.numBanks; i++) {
+            // Folded histories hold as many bits as they are folded to
+            ci[i] = rng() & ((1ULL << g.logSizes[i]) - 1);
+            ct0[i] = rng() & ((1ULL << g.tagWidths[i]) - 1);
+            ct1[i] = rng() & ((1ULL << (g.tagWidths[i] - 1)) - 1);
+        }
+
+        hashes.compute(shifted_pc, path_hist, ci.data(), ct0.data(),
+                       ct1.data(), indices.data(), tags.data());
+        for (int i = 1; i <= g.numBanks; i++) {
+            ASSERT_EQ(indices[i], g.gindex(shifted_pc, path_hist, ci[i], i))
+                << "bank " << i << " of branch " << branch;
+            ASSERT_EQ(tags[i], g.gtag(shifted_pc, ct0[i], ct1[i], i))
+                << "bank " << i << " of branch " << branch;
+        }
+    }
+}
+
+} // anonymous namespace
+
+/** The default geometry of TAGE. */
+TEST(TAGEBankHashesTest, TAGE)
+{
+    compareHashes(Geometry(7, {13, 9, 9, 9, 9, 9, 9, 9},
+                           {0, 9, 9, 10, 10, 11, 11, 12}, 5, 130, 16));
+}
+
+/** The default geometry of LTAGE. */
+TEST(TAGEBankHashesTest, LTAGE)
+{
+    compareHashes(Geometry(12,
+                           {14, 10, 10, 11, 11, 11, 11, 10, 10, 10, 10, 9, 9},
+                           {0, 7, 7, 8, 8, 9, 10, 11, 12, 12, 13, 14, 15},
+                           4, 640, 16));
+}
+
+/** A longer path history than some of the history lengths. */
+TEST(TAGEBankHashesTest, LongPathHistory)
+{
+    compareHashes(Geometry(8, {12, 8, 8, 9, 9, 10, 10, 11, 11},
+                           {0, 8, 8, 9, 9, 10, 10, 11, 11}, 6, 200, 27));
+}
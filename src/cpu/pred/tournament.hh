@@ -47,6 +47,7 @@
 #include "base/sat_counter.hh"
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/history_pool.hh"
 #include "params/TournamentBP.hh"
 
 namespace gem5
@@ -113,7 +114,7 @@ class TournamentBP : public BPredUnit
      * when the BP can use this information to update/restore its
      * state properly.
      */
-    struct BPHistory
+    struct BPHistory : public PooledHistory
     {
 #ifdef GEM5_DEBUG
         BPHistory()
@@ -63,6 +63,9 @@ class BaseTLB;
 class CheckerCPU;
 class Checkpoint;
 class InstDecoder;
+class MemBackdoor;
+class MemBackdoorReq;
+using MemBackdoorPtr = MemBackdoor *;
 class PortProxy;
 class Process;
 class System;
@@ -144,6 +147,13 @@ class ThreadContext : public PCEventScope
 
     virtual void sendFunctional(PacketPtr pkt);
 
+    /**
+     * Request a back door to memory through the data port of the CPU.
+     * The back door is left unset if the port can't provide one.
+     */
+    virtual void sendMemBackdoorReq(const MemBackdoorReq &req,
+                                    MemBackdoorPtr &backdoor);
+
     virtual Process *getProcessPtr() = 0;
 
     virtual void setProcessPtr(Process *p) = 0;
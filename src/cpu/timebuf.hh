@@ -31,15 +31,33 @@
 
 #include <cassert>
 #include <cstring>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace gem5
 {
 
+/**
+ * A circular buffer of T indexed relative to the current time. Slots
+ * entering the future end of the buffer on advance() are normally
+ * destroyed, zeroed and default constructed again. If T provides a
+ * reset() method it is called instead, which lets types whose contents
+ * are mostly empty (e.g. the O3 inter-stage structs) clear only what was
+ * written. reset() must leave the object in the same state as a zeroed,
+ * default constructed one.
+ */
 template <class T>
 class TimeBuffer
 {
   protected:
+    template <class U, class = void>
+    struct HasReset : std::false_type {};
+
+    template <class U>
+    struct HasReset<U, std::void_t<decltype(std::declval<U &>().reset())>>
+        : std::true_type {};
+
     int past;
     int future;
     unsigned size;
@@ -184,9 +202,13 @@ class TimeBuffer
         int ptr = base + future;
         if (ptr >= (int)size)
             ptr -= size;
-        (reinterpret_cast<T *>(index[ptr]))->~T();
-        std::memset(index[ptr], 0, sizeof(T));
-        new (index[ptr]) T;
+        if constexpr (HasReset<T>::value) {
+            reinterpret_cast<T *>(index[ptr])->reset();
+        } else {
+            (reinterpret_cast<T *>(index[ptr]))->~T();
+            std::memset(index[ptr], 0, sizeof(T));
+            new (index[ptr]) T;
+        }
     }
 
   protected:
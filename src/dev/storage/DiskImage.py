@@ -48,5 +48,7 @@ class CowDiskImage(DiskImage):
     cxx_header = "dev/storage/disk_image.hh"
     cxx_class = "gem5::CowDiskImage"
     child = Param.DiskImage(RawDiskImage(read_only=True), "child image")
-    table_size = Param.Int(65536, "initial table size")
+    table_size = Param.Int(
+        65536, "number of sectors to initially reserve memory for"
+    )
     image_file = ""
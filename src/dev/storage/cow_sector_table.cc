@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2001-2005 The Regents of The University of Michigan
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Sector table of the copy-on-write disk image layers
+ */
+
+#include "dev/storage/cow_sector_table.hh"
+
+#include <cstring>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/**
+ * Call a function on each run of consecutive sectors set in a mask, with
+ * the first sector of the run and the number of sectors in it.
+ */
+template <class Mask, class Func>
+void
+forEachRun(const Mask &mask, Func func)
+{
+    for (uint64_t first = 0; first < mask.size();) {
+        if (!mask[first]) {
+            first++;
+            continue;
+        }
+        uint64_t end = first + 1;
+        while (end < mask.size() && mask[end])
+            end++;
+        func(first, end - first);
+        first = end;
+    }
+}
+
+} // anonymous namespace
+
+uint32_t
+CowSectorTable::findSlot(uint64_t extent) const
+{
+    if (extent == lastExtent)
+        return lastSlot;
+
+    const uint32_t slot = extent < slots.size() ? slots[extent] : NoSlot;
+    if (slot != NoSlot) {
+        lastExtent = extent;
+        lastSlot = slot;
+    }
+    return slot;
+}
+
+uint32_t
+CowSectorTable::allocateSlot(uint64_t extent)
+{
+    uint32_t slot = findSlot(extent);
+    if (slot != NoSlot)
+        return slot;
+
+    slot = extents.size();
+    panic_if(slot == NoSlot, "Too many extents in COW disk image");
+
+    if (extent >= slots.size())
+        slots.resize(extent + 1, NoSlot);
+    slots[extent] = slot;
+    extents.push_back(extent);
+    written.emplace_back();
+    data.resize(data.size() + SectorsPerExtent * SectorSize);
+
+    lastExtent = extent;
+    lastSlot = slot;
+    return slot;
+}
+
+std::vector<uint32_t>
+CowSectorTable::sortedSlots() const
+{
+    std::vector<uint32_t> sorted;
+    sorted.reserve(extents.size());
+    for (auto slot : slots) {
+        if (slot != NoSlot)
+            sorted.push_back(slot);
+    }
+    return sorted;
+}
+
+void
+CowSectorTable::init(uint64_t sectors)
+{
+    *this = CowSectorTable();
+
+    const uint64_t num_extents = divCeil(sectors, SectorsPerExtent);
+    extents.reserve(num_extents);
+    written.reserve(num_extents);
+    data.reserve(num_extents * SectorsPerExtent * SectorSize);
+}
+
+const uint8_t *
+CowSectorTable::find(uint64_t sector) const
+{
+    const uint32_t slot = findSlot(sector / SectorsPerExtent);
+    if (slot == NoSlot || !written[slot][sector % SectorsPerExtent])
+        return nullptr;
+    return sectorData(slot, sector);
+}
+
+void
+CowSectorTable::write(const uint8_t *sector_data, uint64_t sector)
+{
+    const uint32_t slot = allocateSlot(sector / SectorsPerExtent);
+    SectorMask &mask = written[slot];
+    if (!mask[sector % SectorsPerExtent]) {
+        mask.set(sector % SectorsPerExtent);
+        numSectors++;
+    }
+    std::memcpy(sectorData(slot, sector), sector_data, SectorSize);
+}
+
+void
+CowSectorTable::forEachSector(
+    const std::function<void(uint64_t, const uint8_t *)> &func) const
+{
+    for (auto slot : sortedSlots()) {
+        const uint64_t base = extents[slot] * SectorsPerExtent;
+        forEachRun(written[slot], [&](uint64_t first, uint64_t count) {
+            for (uint64_t i = first; i < first + count; i++)
+                func(base + i, sectorData(slot, i));
+        });
+    }
+}
+
+void
+SafeRead(std::ifstream &stream, void *data, int count)
+{
+    stream.read((char *)data, count);
+    if (!stream.is_open())
+        panic("file not open");
+
+    if (stream.eof())
+        panic("premature end-of-file");
+
+    if (stream.bad() || stream.fail())
+        panic("error reading cowdisk image");
+}
+
+template<class T>
+void
+SafeRead(std::ifstream &stream, T &data)
+{
+    SafeRead(stream, &data, sizeof(data));
+}
+
+template<class T>
+void
+SafeReadSwap(std::ifstream &stream, T &data)
+{
+    SafeRead(stream, &data, sizeof(data));
+    data = letoh(data); //is this the proper byte order conversion?
+}
+
+bool
+CowSectorTable::load(const std::string &file)
+{
+    std::ifstream stream(file.c_str());
+    if (!stream.is_open())
+        return false;
+
+    if (stream.fail() || stream.bad())
+        panic("Error opening %s", file);
+
+    uint64_t magic;
+    SafeRead(stream, magic);
+
+    if (memcmp(&magic, "COWDISK!", sizeof(magic)) != 0)
+        panic("Could not open %s: Invalid magic", file);
+
+    uint32_t major_version, minor_version;
+    SafeReadSwap(stream, major_version);
+    SafeReadSwap(stream, minor_version);
+
+    if (major_version != 1 && major_version != VersionMajor)
+        panic("Could not open %s: invalid version %d.%d != %d.%d",
+              file, major_version, minor_version, VersionMajor, VersionMinor);
+
+    if (major_version == 1) {
+        // Images of version 1 list the sectors one by one
+        uint64_t sector_count;
+        SafeReadSwap(stream, sector_count);
+        init(sector_count);
+
+        uint8_t sector_data[SectorSize];
+        for (uint64_t i = 0; i < sector_count; i++) {
+            uint64_t offset;
+            SafeReadSwap(stream, offset);
+            SafeRead(stream, sector_data, SectorSize);
+            write(sector_data, offset);
+        }
+    } else {
+        // Images list the extents, each with a mask of the sectors
+        // written followed by the runs of these sectors
+        uint64_t extent_count;
+        SafeReadSwap(stream, extent_count);
+        init(extent_count * SectorsPerExtent);
+
+        for (uint64_t i = 0; i < extent_count; i++) {
+            uint64_t extent;
+            SafeReadSwap(stream, extent);
+            panic_if(findSlot(extent) != NoSlot,
+                     "Could not open %s: extent %d listed twice",
+                     file, extent);
+
+            SectorMask mask;
+            for (uint64_t w = 0; w < SectorsPerExtent / 64; w++) {
+                uint64_t bits;
+                SafeReadSwap(stream, bits);
+                mask |= SectorMask(bits) << (64 * w);
+            }
+
+            const uint32_t slot = allocateSlot(extent);
+            written[slot] = mask;
+            numSectors += mask.count();
+            forEachRun(mask, [&](uint64_t first, uint64_t count) {
+                SafeRead(stream, sectorData(slot, first),
+                         count * SectorSize);
+            });
+        }
+    }
+
+    stream.close();
+    return true;
+}
+
+void
+SafeWrite(std::ofstream &stream, const void *data, int count)
+{
+    stream.write((const char *)data, count);
+    if (!stream.is_open())
+        panic("file not open");
+
+    if (stream.eof())
+        panic("premature end-of-file");
+
+    if (stream.bad() || stream.fail())
+        panic("error reading cowdisk image");
+}
+
+template<class T>
+void
+SafeWrite(std::ofstream &stream, const T &data)
+{
+    SafeWrite(stream, &data, sizeof(data));
+}
+
+template<class T>
+void
+SafeWriteSwap(std::ofstream &stream, const T &data)
+{
+    T swappeddata = letoh(data); //is this the proper byte order conversion?
+    SafeWrite(stream, &swappeddata, sizeof(data));
+}
+
+void
+CowSectorTable::save(const std::string &file) const
+{
+    std::ofstream stream(file.c_str());
+    if (!stream.is_open() || stream.fail() || stream.bad())
+        panic("Error opening %s", file);
+
+    uint64_t magic;
+    memcpy(&magic, "COWDISK!", sizeof(magic));
+    SafeWrite(stream, magic);
+
+    SafeWriteSwap(stream, (uint32_t)VersionMajor);
+    SafeWriteSwap(stream, (uint32_t)VersionMinor);
+    SafeWriteSwap(stream, (uint64_t)extents.size());
+
+    // Only the extents holding written sectors are in the table, and
+    // only their written sectors are saved, a run at a time
+    const SectorMask word_mask(UINT64_MAX);
+    for (auto slot : sortedSlots()) {
+        const SectorMask &mask = written[slot];
+        SafeWriteSwap(stream, extents[slot]);
+        for (uint64_t w = 0; w < SectorsPerExtent / 64; w++) {
+            SafeWriteSwap(stream,
+                (uint64_t)((mask >> (64 * w)) & word_mask).to_ullong());
+        }
+        forEachRun(mask, [&](uint64_t first, uint64_t count) {
+            SafeWrite(stream, sectorData(slot, first), count * SectorSize);
+        });
+    }
+
+    stream.close();
+}
+
+} // namespace gem5
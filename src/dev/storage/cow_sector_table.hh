@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2001-2005 The Regents of The University of Michigan
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Sector table of the copy-on-write disk image layers
+ */
+
+#ifndef __DEV_STORAGE_COW_SECTOR_TABLE_HH__
+#define __DEV_STORAGE_COW_SECTOR_TABLE_HH__
+
+#include <bitset>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define SectorSize (512)
+
+namespace gem5
+{
+
+/**
+ * The sectors written to a copy-on-write disk image layer, grouped in
+ * extents of contiguous sectors. The extents are allocated in slots of a
+ * pool, the slot of each extent being found in a table indexed by extent
+ * number, so that writing a sector doesn't allocate memory but when it
+ * starts a new extent, and sequential accesses stay in the same extent.
+ */
+class CowSectorTable
+{
+  public:
+    static constexpr uint32_t VersionMajor = 2;
+    static constexpr uint32_t VersionMinor = 0;
+
+    /** Number of sectors of the extents, 64KiB. */
+    static constexpr uint64_t SectorsPerExtent = 128;
+
+  private:
+    typedef std::bitset<SectorsPerExtent> SectorMask;
+
+    /** Slot of the extents which have no sector written. */
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+
+    /** Slot of each extent, NoSlot for extents not written. */
+    std::vector<uint32_t> slots;
+    /** Contents of the extents, one after the other in slot order. */
+    std::vector<uint8_t> data;
+    /** Sectors written in each slot. */
+    std::vector<SectorMask> written;
+    /** Extent in each slot. */
+    std::vector<uint64_t> extents;
+    /** Number of sectors written. */
+    uint64_t numSectors = 0;
+
+    /**
+     * Last extent found, and its slot. Lookups update this cache, so the
+     * table may only be accessed by one host thread at a time, even to
+     * read it. IdeDisk waits for its read on a host thread to complete
+     * before accessing the image again.
+     */
+    mutable uint64_t lastExtent = UINT64_MAX;
+    mutable uint32_t lastSlot = NoSlot;
+
+    /** Slot of an extent, NoSlot if none of its sectors were written. */
+    uint32_t findSlot(uint64_t extent) const;
+
+    /** Slot of an extent, allocating it if needed. */
+    uint32_t allocateSlot(uint64_t extent);
+
+    /** Contents of a sector of a slot. */
+    const uint8_t *
+    sectorData(uint32_t slot, uint64_t sector) const
+    {
+        return data.data() +
+            (slot * SectorsPerExtent + sector % SectorsPerExtent) *
+            SectorSize;
+    }
+
+    uint8_t *
+    sectorData(uint32_t slot, uint64_t sector)
+    {
+        return data.data() +
+            (slot * SectorsPerExtent + sector % SectorsPerExtent) *
+            SectorSize;
+    }
+
+    /** Slots of the extents, in extent order. */
+    std::vector<uint32_t> sortedSlots() const;
+
+  public:
+    /**
+     * Empty the table.
+     *
+     * @param sectors Number of sectors to reserve memory for.
+     */
+    void init(uint64_t sectors);
+
+    /** Number of sectors written. */
+    uint64_t size() const { return numSectors; }
+
+    /** Contents of a sector, nullptr if it was not written. */
+    const uint8_t *find(uint64_t sector) const;
+
+    /** Copy a sector into the table. */
+    void write(const uint8_t *data, uint64_t sector);
+
+    /** Call a function on each sector written, in sector order. */
+    void forEachSector(
+        const std::function<void(uint64_t, const uint8_t *)> &func) const;
+
+    /**
+     * Replace the table by the one saved in a file, of the current or of
+     * the first version of the format.
+     *
+     * @return false if the file can't be opened.
+     */
+    bool load(const std::string &file);
+
+    /** Save the table in a file. */
+    void save(const std::string &file) const;
+};
+
+void SafeRead(std::ifstream &stream, void *data, int count);
+
+template<class T>
+void SafeRead(std::ifstream &stream, T &data);
+
+template<class T>
+void SafeReadSwap(std::ifstream &stream, T &data);
+
+void SafeWrite(std::ofstream &stream, const void *data, int count);
+
+template<class T>
+void SafeWrite(std::ofstream &stream, const T &data);
+
+template<class T>
+void SafeWriteSwap(std::ofstream &stream, const T &data);
+
+} // namespace gem5
+
+#endif // __DEV_STORAGE_COW_SECTOR_TABLE_HH__
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Tests of the sector table of the copy-on-write disk images.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "dev/storage/cow_sector_table.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class CowSectorTableTest : public ::testing::Test
+{
+  protected:
+    const std::string path =
+        ::testing::TempDir() + "cow_sector_table.test.cow";
+
+    /** Sectors written, in two extents and across their boundary. */
+    const std::vector<uint64_t> sectors{
+        3, 4, 5, 127, 128, 129, 1000, 1001, 1, 4};
+
+    /** Contents of a sector, depending on its number and a version. */
+    static std::vector<uint8_t>
+    contents(uint64_t sector, uint8_t version)
+    {
+        std::vector<uint8_t> data(SectorSize);
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = sector * 7 + i + version;
+        return data;
+    }
+
+    void
+    fill(CowSectorTable &table)
+    {
+        table.init(0);
+        // Sector 4 is written twice
+        for (size_t i = 0; i < sectors.size(); i++)
+            table.write(contents(sectors[i], i).data(), sectors[i]);
+    }
+
+    /** Check that a table holds the last contents of each sector. */
+    void
+    check(const CowSectorTable &table)
+    {
+        EXPECT_EQ(table.size(), sectors.size() - 1);
+        for (size_t i = 0; i < sectors.size(); i++) {
+            size_t last = i;
+            for (size_t j = i; j < sectors.size(); j++) {
+                if (sectors[j] == sectors[i])
+                    last = j;
+            }
+            const uint8_t *data = table.find(sectors[i]);
+            ASSERT_NE(data, nullptr);
+            EXPECT_EQ(std::memcmp(data, contents(sectors[i], last).data(),
+                                  SectorSize), 0);
+        }
+        EXPECT_EQ(table.find(0), nullptr);
+        EXPECT_EQ(table.find(126), nullptr);
+        EXPECT_EQ(table.find(2000), nullptr);
+    }
+
+    void TearDown() override { std::remove(path.c_str()); }
+};
+
+} // anonymous namespace
+
+TEST_F(CowSectorTableTest, ReadWrite)
+{
+    CowSectorTable table;
+    fill(table);
+    check(table);
+}
+
+/** The sectors are visited once each, in sector order. */
+TEST_F(CowSectorTableTest, ForEachSector)
+{
+    CowSectorTable table;
+    fill(table);
+    std::vector<uint64_t> visited;
+    table.forEachSector([&](uint64_t sector, const uint8_t *data) {
+        EXPECT_EQ(data, table.find(sector));
+        visited.push_back(sector);
+    });
+    EXPECT_EQ(visited, (std::vector<uint64_t>{
+        1, 3, 4, 5, 127, 128, 129, 1000, 1001}));
+}
+
+TEST_F(CowSectorTableTest, SaveLoad)
+{
+    CowSectorTable table;
+    fill(table);
+    table.save(path);
+
+    CowSectorTable loaded;
+    ASSERT_TRUE(loaded.load(path));
+    check(loaded);
+}
+
+/** Images of the first version list the sectors one by one. */
+TEST_F(CowSectorTableTest, LoadVersion1)
+{
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream.write("COWDISK!", 8);
+        const uint32_t version[2] = {1, 0};
+        stream.write((const char *)version, sizeof(version));
+        const uint64_t count = sectors.size();
+        stream.write((const char *)&count, sizeof(count));
+        for (size_t i = 0; i < sectors.size(); i++) {
+            stream.write((const char *)&sectors[i], sizeof(sectors[i]));
+            stream.write((const char *)contents(sectors[i], i).data(),
+                         SectorSize);
+        }
+    }
+
+    CowSectorTable loaded;
+    ASSERT_TRUE(loaded.load(path));
+    check(loaded);
+}
+
+TEST_F(CowSectorTableTest, LoadMissing)
+{
+    CowSectorTable table;
+    EXPECT_FALSE(table.load(path));
+}
@@ -39,6 +39,8 @@
 #include <cerrno>
 #include <cstring>
 #include <fstream>
+#include <future>
+#include <memory>
 #include <string>
 
 #include "base/callback.hh"
@@ -53,6 +55,52 @@
 namespace gem5
 {
 
+////////////////////////////////////////////////////////////////////////
+//
+// Disk image
+//
+void
+DiskImage::notifyFork()
+{
+    // Drained before the fork, so the host thread is idle
+    readPool.notifyFork();
+}
+
+void
+DiskImage::traceRead(const uint8_t *data, std::streampos offset,
+                     uint64_t bytes) const
+{
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", (uint64_t)offset,
+            bytes / SectorSize);
+    DDUMP(DiskImageRead, data, bytes);
+}
+
+uint64_t
+DiskImage::AsyncRead::get()
+{
+    const uint64_t bytes_read = bytes.get();
+    image->traceRead(data, offset, bytes_read);
+    return bytes_read;
+}
+
+DiskImage::AsyncRead
+DiskImage::readAsync(uint8_t *data, std::streampos offset,
+                     uint64_t count) const
+{
+    auto task = std::make_shared<std::packaged_task<uint64_t()>>(
+        [this, data, offset, count]() {
+            return readSectors(data, offset, count);
+        });
+
+    AsyncRead async_read;
+    async_read.image = this;
+    async_read.data = data;
+    async_read.offset = offset;
+    async_read.bytes = task->get_future();
+    readPool.run([task]() { (*task)(); });
+    return async_read;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
@@ -71,6 +119,8 @@ RawDiskImage::~RawDiskImage()
 void
 RawDiskImage::notifyFork()
 {
+    DiskImage::notifyFork();
+
     if (initialized && !readonly)
         panic("Attempting to fork system with read-write raw disk image.");
 
@@ -105,6 +155,7 @@ RawDiskImage::close()
 std::streampos
 RawDiskImage::size() const
 {
+    std::lock_guard<std::mutex> lock(streamMutex);
     if (disk_size == 0) {
         if (!stream.is_open())
             panic("file not open!\n");
@@ -121,6 +172,7 @@ RawDiskImage::read(uint8_t *data, std::streampos offset) const
     if (!initialized)
         panic("RawDiskImage not initialized");
 
+    std::lock_guard<std::mutex> lock(streamMutex);
     if (!stream.is_open())
         panic("file not open!\n");
 
@@ -146,6 +198,7 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     if (readonly)
         panic("Cannot write to a read only disk image");
 
+    std::lock_guard<std::mutex> lock(streamMutex);
     if (!stream.is_open())
         panic("file not open!\n");
 
@@ -161,15 +214,37 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     return stream.tellp() - pos;
 }
 
+uint64_t
+RawDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                          uint64_t count) const
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    std::lock_guard<std::mutex> lock(streamMutex);
+    if (!stream.is_open())
+        panic("file not open!\n");
+
+    // Read all the sectors at once, reading past the end of the image
+    // only setting the stream state
+    stream.clear();
+    stream.seekg(offset * SectorSize, std::ios::beg);
+    if (!stream.good())
+        panic("Could not seek to location in file");
+
+    stream.read((char *)data, count * SectorSize);
+    const uint64_t bytes = stream.gcount();
+    stream.clear();
+
+    return bytes;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Copy on Write Disk image
 //
-const uint32_t CowDiskImage::VersionMajor = 1;
-const uint32_t CowDiskImage::VersionMinor = 0;
-
 CowDiskImage::CowDiskImage(const Params &p)
-    : DiskImage(p), filename(p.image_file), child(p.child), table(NULL)
+    : DiskImage(p), filename(p.image_file), child(p.child)
 {
     if (filename.empty()) {
         initSectorTable(p.table_size);
@@ -185,20 +260,11 @@ CowDiskImage::CowDiskImage(const Params &p)
     }
 }
 
-CowDiskImage::~CowDiskImage()
-{
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
-
-    while (i != end) {
-        delete (*i).second;
-        ++i;
-    }
-}
-
 void
 CowDiskImage::notifyFork()
 {
+    DiskImage::notifyFork();
+
     if (!dynamic_cast<const Params &>(params()).read_only &&
         !filename.empty()) {
         inform("Disabling saving of COW image in forked child process.\n");
@@ -206,117 +272,23 @@ CowDiskImage::notifyFork()
     }
 }
 
-void
-SafeRead(std::ifstream &stream, void *data, int count)
-{
-    stream.read((char *)data, count);
-    if (!stream.is_open())
-        panic("file not open");
-
-    if (stream.eof())
-        panic("premature end-of-file");
-
-    if (stream.bad() || stream.fail())
-        panic("error reading cowdisk image");
-}
-
-template<class T>
-void
-SafeRead(std::ifstream &stream, T &data)
-{
-    SafeRead(stream, &data, sizeof(data));
-}
-
-template<class T>
-void
-SafeReadSwap(std::ifstream &stream, T &data)
-{
-    SafeRead(stream, &data, sizeof(data));
-    data = letoh(data); //is this the proper byte order conversion?
-}
-
 bool
 CowDiskImage::open(const std::string &file)
 {
-    std::ifstream stream(file.c_str());
-    if (!stream.is_open())
+    if (!table.load(file))
         return false;
 
-    if (stream.fail() || stream.bad())
-        panic("Error opening %s", file);
-
-    uint64_t magic;
-    SafeRead(stream, magic);
-
-    if (memcmp(&magic, "COWDISK!", sizeof(magic)) != 0)
-        panic("Could not open %s: Invalid magic", file);
-
-    uint32_t major_version, minor_version;
-    SafeReadSwap(stream, major_version);
-    SafeReadSwap(stream, minor_version);
-
-    if (major_version != VersionMajor && minor_version != VersionMinor)
-        panic("Could not open %s: invalid version %d.%d != %d.%d",
-              file, major_version, minor_version, VersionMajor, VersionMinor);
-
-    uint64_t sector_count;
-    SafeReadSwap(stream, sector_count);
-    table = new SectorTable(sector_count);
-
-
-    for (uint64_t i = 0; i < sector_count; i++) {
-        uint64_t offset;
-        SafeReadSwap(stream, offset);
-
-        Sector *sector = new Sector;
-        SafeRead(stream, sector, sizeof(Sector));
-
-        assert(table->find(offset) == table->end());
-        (*table)[offset] = sector;
-    }
-
-    stream.close();
-
     initialized = true;
     return true;
 }
 
 void
-CowDiskImage::initSectorTable(int hash_size)
+CowDiskImage::initSectorTable(uint64_t sectors)
 {
-    table = new SectorTable(hash_size);
-
+    table.init(sectors);
     initialized = true;
 }
 
-void
-SafeWrite(std::ofstream &stream, const void *data, int count)
-{
-    stream.write((const char *)data, count);
-    if (!stream.is_open())
-        panic("file not open");
-
-    if (stream.eof())
-        panic("premature end-of-file");
-
-    if (stream.bad() || stream.fail())
-        panic("error reading cowdisk image");
-}
-
-template<class T>
-void
-SafeWrite(std::ofstream &stream, const T &data)
-{
-    SafeWrite(stream, &data, sizeof(data));
-}
-
-template<class T>
-void
-SafeWriteSwap(std::ofstream &stream, const T &data)
-{
-    T swappeddata = letoh(data); //is this the proper byte order conversion?
-    SafeWrite(stream, &swappeddata, sizeof(data));
-}
 void
 CowDiskImage::save() const
 {
@@ -333,44 +305,15 @@ CowDiskImage::save(const std::string &file) const
     if (!initialized)
         panic("RawDiskImage not initialized");
 
-    std::ofstream stream(file.c_str());
-    if (!stream.is_open() || stream.fail() || stream.bad())
-        panic("Error opening %s", file);
-
-    uint64_t magic;
-    memcpy(&magic, "COWDISK!", sizeof(magic));
-    SafeWrite(stream, magic);
-
-    SafeWriteSwap(stream, (uint32_t)VersionMajor);
-    SafeWriteSwap(stream, (uint32_t)VersionMinor);
-    SafeWriteSwap(stream, (uint64_t)table->size());
-
-    uint64_t size = table->size();
-    SectorTable::iterator iter = table->begin();
-    SectorTable::iterator end = table->end();
-
-    for (uint64_t i = 0; i < size; i++) {
-        if (iter == end)
-            panic("Incorrect Table Size during save of COW disk image");
-
-        SafeWriteSwap(stream, (uint64_t)(*iter).first);
-        SafeWrite(stream, (*iter).second->data, sizeof(Sector));
-        ++iter;
-    }
-
-    stream.close();
+    table.save(file);
 }
 
 void
 CowDiskImage::writeback()
 {
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
-
-    while (i != end) {
-        child->write((*i).second->data, (*i).first);
-        ++i;
-    }
+    table.forEachSector([&](uint64_t sector, const uint8_t *data) {
+        child->write(data, sector);
+    });
 }
 
 std::streampos
@@ -386,17 +329,47 @@ CowDiskImage::read(uint8_t *data, std::streampos offset) const
     if (offset > size())
         panic("access out of bounds");
 
-    SectorTable::const_iterator i = table->find(offset);
-    if (i == table->end())
+    const uint8_t *sector = table.find(offset);
+    if (!sector)
         return child->read(data, offset);
     else {
-        memcpy(data, (*i).second->data, SectorSize);
+        memcpy(data, sector, SectorSize);
         DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
         DDUMP(DiskImageRead, data, SectorSize);
         return SectorSize;
     }
 }
 
+uint64_t
+CowDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                          uint64_t count) const
+{
+    if (!initialized)
+        panic("CowDiskImage not initialized");
+
+    // Read the runs of sectors not written to this layer from the child
+    uint64_t bytes = 0;
+    for (uint64_t sector = offset; sector < (uint64_t)offset + count;) {
+        if (const uint8_t *sector_data = table.find(sector)) {
+            memcpy(data + bytes, sector_data, SectorSize);
+            bytes += SectorSize;
+            sector++;
+            continue;
+        }
+
+        uint64_t end = sector + 1;
+        while (end < (uint64_t)offset + count && !table.find(end))
+            end++;
+        const uint64_t child_bytes =
+            child->readSectors(data + bytes, sector, end - sector);
+        bytes += child_bytes;
+        if (child_bytes != (end - sector) * SectorSize)
+            break;
+        sector = end;
+    }
+    return bytes;
+}
+
 std::streampos
 CowDiskImage::write(const uint8_t *data, std::streampos offset)
 {
@@ -406,14 +379,7 @@ CowDiskImage::write(const uint8_t *data, std::streampos offset)
     if (offset > size())
         panic("access out of bounds");
 
-    SectorTable::iterator i = table->find(offset);
-    if (i == table->end()) {
-        Sector *sector = new Sector;
-        memcpy(sector, data, SectorSize);
-        table->insert(make_pair(offset, sector));
-    } else {
-        memcpy((*i).second->data, data, SectorSize);
-    }
+    table.write(data, offset);
 
     DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
     DDUMP(DiskImageWrite, data, SectorSize);
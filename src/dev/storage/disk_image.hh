@@ -33,16 +33,18 @@
 #ifndef __DEV_STORAGE_DISK_IMAGE_HH__
 #define __DEV_STORAGE_DISK_IMAGE_HH__
 
+#include <cstdint>
 #include <fstream>
-#include <unordered_map>
+#include <future>
+#include <mutex>
 
+#include "base/worker_pool.hh"
+#include "dev/storage/cow_sector_table.hh"
 #include "params/CowDiskImage.hh"
 #include "params/DiskImage.hh"
 #include "params/RawDiskImage.hh"
 #include "sim/sim_object.hh"
 
-#define SectorSize (512)
-
 namespace gem5
 {
 
@@ -54,17 +56,77 @@ class DiskImage : public SimObject
   protected:
     bool initialized;
 
+    /**
+     * Host thread reading the image for readAsync(). A single one is
+     * enough, as the accesses to an image are serialized anyway.
+     */
+    mutable WorkerPool readPool;
+
+    /** Trace a read done on a host thread. */
+    void traceRead(const uint8_t *data, std::streampos offset,
+                   uint64_t bytes) const;
+
   public:
     typedef DiskImageParams Params;
-    DiskImage(const Params &p) : SimObject(p), initialized(false) {}
+    DiskImage(const Params &p)
+        : SimObject(p), initialized(false), readPool(1)
+    {}
     virtual ~DiskImage() {}
 
+    void notifyFork() override;
+
     virtual std::streampos size() const = 0;
 
     virtual std::streampos read(uint8_t *data,
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Read consecutive sectors, stopping at the first one which can't be
+     * read. The read is not traced, so that host threads other than the
+     * simulation thread may call this.
+     *
+     * @param data Buffer for the sectors.
+     * @param offset First sector to read.
+     * @param count Number of sectors to read.
+     * @return The number of bytes read.
+     */
+    virtual uint64_t readSectors(uint8_t *data, std::streampos offset,
+                                 uint64_t count) const = 0;
+
+    /** A read of the image on a host thread. */
+    class AsyncRead
+    {
+      private:
+        friend class DiskImage;
+
+        const DiskImage *image = nullptr;
+        const uint8_t *data = nullptr;
+        std::streampos offset = 0;
+        std::future<uint64_t> bytes;
+
+      public:
+        /** Whether the read was started and not waited for yet. */
+        bool valid() const { return bytes.valid(); }
+
+        /**
+         * Wait for the read to complete, and trace it.
+         *
+         * @return The number of bytes read.
+         */
+        uint64_t get();
+    };
+
+    /**
+     * Read consecutive sectors on the host thread of the image, so that
+     * the simulation carries on while the host reads the image. Neither
+     * the image nor the buffer may be accessed until the read completes,
+     * which waiting on the read tells. The read is traced when waited
+     * on, as the traces are written by the simulation thread.
+     */
+    AsyncRead readAsync(uint8_t *data, std::streampos offset,
+                        uint64_t count) const;
 };
 
 /**
@@ -74,6 +136,9 @@ class RawDiskImage : public DiskImage
 {
   protected:
     mutable std::fstream stream;
+    /** Serializes the accesses to the stream of the image, which may
+     *  be read by several host threads. */
+    mutable std::mutex streamMutex;
     std::string file;
     bool readonly;
     mutable std::streampos disk_size;
@@ -92,6 +157,9 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    uint64_t readSectors(uint8_t *data, std::streampos offset,
+                         uint64_t count) const override;
 };
 
 /**
@@ -106,30 +174,23 @@ class RawDiskImage : public DiskImage
  */
 class CowDiskImage : public DiskImage
 {
-  public:
-    static const uint32_t VersionMajor;
-    static const uint32_t VersionMinor;
-
-  protected:
-    struct Sector
-    {
-        uint8_t data[SectorSize];
-    };
-    typedef std::unordered_map<uint64_t, Sector *> SectorTable;
-
   protected:
     std::string filename;
     DiskImage *child;
-    SectorTable *table;
+    CowSectorTable table;
 
   public:
     typedef CowDiskImageParams Params;
     CowDiskImage(const Params &p);
-    ~CowDiskImage();
 
     void notifyFork() override;
 
-    void initSectorTable(int hash_size);
+    /**
+     * Start with an empty sector table.
+     *
+     * @param sectors Number of sectors to reserve memory for.
+     */
+    void initSectorTable(uint64_t sectors);
     bool open(const std::string &file);
     void save() const;
     void save(const std::string &file) const;
@@ -142,23 +203,10 @@ class CowDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
-};
-
-void SafeRead(std::ifstream &stream, void *data, int count);
 
-template<class T>
-void SafeRead(std::ifstream &stream, T &data);
-
-template<class T>
-void SafeReadSwap(std::ifstream &stream, T &data);
-
-void SafeWrite(std::ofstream &stream, const void *data, int count);
-
-template<class T>
-void SafeWrite(std::ofstream &stream, const T &data);
-
-template<class T>
-void SafeWriteSwap(std::ofstream &stream, const T &data);
+    uint64_t readSectors(uint8_t *data, std::streampos offset,
+                         uint64_t count) const override;
+};
 
 } // namespace gem5
 
@@ -53,6 +53,7 @@
 #include "base/chunk_generator.hh"
 #include "base/compiler.hh"
 #include "base/cprintf.hh" // csprintf
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/IdeDisk.hh"
 #include "dev/storage/disk_image.hh"
@@ -137,6 +138,8 @@ IdeDisk::IdeDisk(const Params &p)
 
 IdeDisk::~IdeDisk()
 {
+    waitDiskRead();
+
     // destroy the data buffer
     delete [] dataBuffer;
 }
@@ -144,6 +147,8 @@ IdeDisk::~IdeDisk()
 void
 IdeDisk::reset(int id)
 {
+    waitDiskRead();
+
     // initialize the data buffer and shadow registers
     dataBuffer = new uint8_t[MAX_DMA_SIZE];
 
@@ -159,6 +164,7 @@ IdeDisk::reset(int id)
     dmaRead = false;
     pendingInterrupt = false;
     dmaAborted = false;
+    pendingReadBytes = 0;
 
     // set the device state to idle
     dmaState = Dma_Idle;
@@ -479,13 +485,18 @@ IdeDisk::doDmaDataWrite()
     DPRINTF(IdeDisk, "doDmaWrite, diskDelay: %d totalDiskDelay: %d\n",
             diskDelay, totalDiskDelay);
 
+    waitDiskRead();
     memset(dataBuffer, 0, MAX_DMA_SIZE);
     assert(cmdBytesLeft <= MAX_DMA_SIZE);
-    while (bytesRead < curPrd.getByteCount()) {
-        readDisk(curSector++, (uint8_t *)(dataBuffer + bytesRead));
-        bytesRead += SectorSize;
-        cmdBytesLeft -= SectorSize;
-    }
+
+    // Let the host read the sectors while the transfer is delayed
+    const uint32_t sectors = divCeil(curPrd.getByteCount(), SectorSize);
+    bytesRead = sectors * SectorSize;
+    pendingRead = image->readAsync(dataBuffer, curSector, sectors);
+    pendingReadBytes = bytesRead;
+    curSector += sectors;
+    cmdBytesLeft -= bytesRead;
+
     DPRINTF(IdeDisk, "doDmaWrite, bytesRead: %d cmdBytesLeft: %d\n",
             bytesRead, cmdBytesLeft);
 
@@ -495,6 +506,8 @@ IdeDisk::doDmaDataWrite()
 void
 IdeDisk::doDmaWrite()
 {
+    waitDiskRead();
+
     if (dmaAborted) {
         DPRINTF(IdeDisk, "DMA Aborted while doing DMA Write\n");
         if (dmaWriteCG)
@@ -553,9 +566,23 @@ IdeDisk::dmaWriteDone()
 // Disk utility routines
 ///
 
+void
+IdeDisk::waitDiskRead() const
+{
+    if (!pendingRead.valid())
+        return;
+
+    const uint64_t bytesRead = pendingRead.get();
+    panic_if(bytesRead != pendingReadBytes,
+            "Can't read from %s. Only %d of %d read.",
+            name(), bytesRead, pendingReadBytes);
+}
+
 void
 IdeDisk::readDisk(uint32_t sector, uint8_t *data)
 {
+    waitDiskRead();
+
     uint32_t bytesRead = image->read(data, sector);
 
     panic_if(bytesRead != SectorSize,
@@ -566,6 +593,8 @@ IdeDisk::readDisk(uint32_t sector, uint8_t *data)
 void
 IdeDisk::writeDisk(uint32_t sector, uint8_t *data)
 {
+    waitDiskRead();
+
     uint32_t bytesWritten = image->write(data, sector);
 
     panic_if(bytesWritten != SectorSize,
@@ -1064,9 +1093,29 @@ IdeDisk::updateState(DevAction_t action)
     }
 }
 
+DrainState
+IdeDisk::drain()
+{
+    // The image must not be read from the host thread while drained
+    waitDiskRead();
+    return DrainState::Drained;
+}
+
+void
+IdeDisk::notifyFork()
+{
+    // Drained before the fork, which waited for any read of the image.
+    // The child doesn't have the host thread of the image, so it could
+    // never wait for one that is still running.
+    waitDiskRead();
+}
+
 void
 IdeDisk::serialize(CheckpointOut &cp) const
 {
+    // The data buffer must hold the sectors read
+    waitDiskRead();
+
     // Check all outstanding events to see if they are scheduled
     // these are all mutually exclusive
     Tick reschedule = 0;
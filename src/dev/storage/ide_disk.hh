@@ -264,6 +264,12 @@ class IdeDisk : public SimObject
     bool pendingInterrupt;
     /** DMA Aborted */
     bool dmaAborted;
+    /** Read of the image into the data buffer for the current DMA
+     *  transfer to memory, done by the host while the transfer is
+     *  delayed */
+    mutable DiskImage::AsyncRead pendingRead;
+    /** Number of bytes the pending read reads */
+    uint64_t pendingReadBytes;
 
     struct IdeDiskStats : public statistics::Group
     {
@@ -350,6 +356,12 @@ class IdeDisk : public SimObject
     void readDisk(uint32_t sector, uint8_t *data);
     void writeDisk(uint32_t sector, uint8_t *data);
 
+    /**
+     * Wait for the pending read of the image, if any. The image and the
+     * data buffer may only be accessed once it completes.
+     */
+    void waitDiskRead() const;
+
     // State machine management
     void updateState(DevAction_t action);
 
@@ -380,6 +392,9 @@ class IdeDisk : public SimObject
 
     inline Addr pciToDma(Addr pciAddr);
 
+    DrainState drain() override;
+    void notifyFork() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 };
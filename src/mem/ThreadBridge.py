@@ -39,8 +39,11 @@ class ThreadBridge(SimObject):
     the issue. The receiver side is expected to use the same EventQueue that
     the ThreadBridge is using.
 
-    Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    Atomic and functional accesses are made on the event queue of the
+    ThreadBridge right away. Timing packets are delivered to the event queue
+    of the other side after the delay of the bridge, which must be at least
+    the simulation quantum (Root.sim_quantum) when the two sides run on
+    different event queues. The bridge holds any number of packets.
 
     Example:
 
@@ -58,3 +61,5 @@ class ThreadBridge(SimObject):
 
     in_port = ResponsePort("Incoming port")
     out_port = RequestPort("Outgoing port")
+
+    delay = Param.Latency("0t", "Latency of the timing packets")
@@ -445,7 +445,8 @@ AbstractMemory::access(PacketPtr pkt)
             // to do the LL/SC tracking here
             trackLoadLocked(pkt);
         }
-        if (pmemAddr) {
+        // backdoor packets already point at the data
+        if (pmemAddr && !pkt->hasBackdoorData()) {
             pkt->setData(host_addr);
         }
         TRACE_PACKET(pkt->req->isInstFetch() ? "IFetch" : "Read");
@@ -464,7 +465,7 @@ AbstractMemory::access(PacketPtr pkt)
         // no need to do anything
     } else if (pkt->isWrite()) {
         if (writeOK(pkt)) {
-            if (pmemAddr) {
+            if (pmemAddr && !pkt->hasBackdoorData()) {
                 pkt->writeData(host_addr);
                 DPRINTF(MemoryAccess, "%s write due to %s\n",
                         __func__, pkt->print());
@@ -105,6 +105,12 @@ class BaseCache(ClockedObject):
 
     is_read_only = Param.Bool(False, "Is this cache read only (e.g. inst)")
 
+    warm_only = Param.Bool(
+        False,
+        "Service atomic accesses through a tags-only warmup path that "
+        "skips latency calculation and trains the prefetcher",
+    )
+
     prefetcher = Param.BasePrefetcher(NULL, "Prefetcher attached to cache")
 
     tags = Param.BaseTags(BaseSetAssoc(), "Tag store")
@@ -152,6 +158,15 @@ class BaseCache(ClockedObject):
     # set to False.
     writeback_clean = Param.Bool(False, "Writeback clean lines")
 
+    # In atomic mode, move the data of fills and writebacks directly
+    # between the cache blocks and the backing store of the memory below,
+    # if the memory provides a backdoor, instead of copying it in and out
+    # of the packets. This only pays off for caches directly above the
+    # memory. Only atomic mode is supported: in timing mode, where packets
+    # are queued on their way to the memory, the data is always carried
+    # by the packets.
+    mem_backdoor = Param.Bool(False, "Access memory through backdoors")
+
     # Control whether this cache should be mostly inclusive or mostly
     # exclusive with respect to upstream caches. The behaviour on a
     # fill is determined accordingly. For a mostly inclusive cache,
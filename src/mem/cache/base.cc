@@ -45,6 +45,8 @@
 
 #include "mem/cache/base.hh"
 
+#include <cstring>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "debug/Cache.hh"
@@ -91,6 +93,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       prefetcher(p.prefetcher),
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
+      useMemBackdoor(p.mem_backdoor),
       tempBlockWriteback(nullptr),
       writebackTempBlockAtomicEvent([this]{ writebackTempBlockAtomic(); },
                                     name(), false,
@@ -108,6 +111,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       isReadOnly(p.is_read_only),
       replaceExpansions(p.replace_expansions),
       moveContractions(p.move_contractions),
+      warmOnly(p.warm_only),
       blocked(0),
       order(0),
       noTargetMSHR(nullptr),
@@ -641,6 +645,10 @@ BaseCache::recvAtomic(PacketPtr pkt)
     // writebacks... that would mean that someone used an atomic
     // access in timing mode
 
+    if (warmOnly && warmAccess(pkt)) {
+        return 0;
+    }
+
     // We use lookupLatency here because it is used to specify the latency
     // to access.
     Cycles lat = lookupLatency;
@@ -649,6 +657,15 @@ BaseCache::recvAtomic(PacketPtr pkt)
     PacketList writebacks;
     bool satisfied = access(pkt, blk, lat, writebacks);
 
+    if (warmOnly) {
+        // train the prefetcher as the timing path would
+        if (satisfied) {
+            ppHit->notify(CacheAccessProbeArg(pkt, accessor));
+        } else {
+            ppMiss->notify(CacheAccessProbeArg(pkt, accessor));
+        }
+    }
+
     if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit)) {
         // A cache clean opearation is looking for a dirty
         // block. If a dirty block is encountered a WriteClean
@@ -670,16 +687,13 @@ BaseCache::recvAtomic(PacketPtr pkt)
         lat += handleAtomicReqMiss(pkt, blk, writebacks);
     }
 
-    // Note that we don't invoke the prefetcher at all in atomic mode.
-    // It's not clear how to do it properly, particularly for
-    // prefetchers that aggressively generate prefetch candidates and
-    // rely on bandwidth contention to throttle them; these will tend
-    // to pollute the cache in atomic mode since there is no bandwidth
-    // contention.  If we ever do want to enable prefetching in atomic
-    // mode, though, this is the place to do it... see timingAccess()
-    // for an example (though we'd want to issue the prefetch(es)
-    // immediately rather than calling requestMemSideBus() as we do
-    // there).
+    // Note that we don't invoke the prefetcher in atomic mode unless
+    // the cache is warm-only. It's not clear how to do it properly,
+    // particularly for prefetchers that aggressively generate prefetch
+    // candidates and rely on bandwidth contention to throttle them;
+    // these will tend to pollute the cache in atomic mode since there
+    // is no bandwidth contention. For warming this is acceptable, and
+    // the prefetches are issued at the end of this function.
 
     // do any writebacks resulting from the response handling
     doWritebacksAtomic(writebacks);
@@ -707,6 +721,10 @@ BaseCache::recvAtomic(PacketPtr pkt)
         tempBlockWriteback = evictBlock(blk);
     }
 
+    if (warmOnly && prefetcher) {
+        warmPrefetches();
+    }
+
     if (pkt->needsResponse()) {
         pkt->makeAtomicResponse();
     }
@@ -714,6 +732,78 @@ BaseCache::recvAtomic(PacketPtr pkt)
     return lat * clockPeriod();
 }
 
+bool
+BaseCache::warmAccess(PacketPtr pkt)
+{
+    // Only plain demand accesses take the shortcut, anything that may
+    // need coherence actions is left to the regular atomic path
+    if ((pkt->cmd != MemCmd::ReadReq && pkt->cmd != MemCmd::WriteReq) ||
+        pkt->req->isUncacheable() || pkt->req->isCacheMaintenance() ||
+        pkt->req->isLockedRMW()) {
+        return false;
+    }
+
+    CacheBlk *blk = tags->findBlock(pkt->getAddr(), pkt->isSecure());
+    if (!blk || !blk->isSet(pkt->needsWritable() ?
+                            CacheBlk::WritableBit : CacheBlk::ReadableBit)) {
+        return false;
+    }
+
+    tags->warmBlock(blk, pkt);
+    incHitCount(pkt);
+
+    ppHit->notify(CacheAccessProbeArg(pkt, accessor));
+    if (prefetcher) {
+        blk->clearPrefetched();
+    }
+
+    satisfyRequest(pkt, blk);
+    if (pkt->needsResponse()) {
+        pkt->makeAtomicResponse();
+    }
+
+    if (prefetcher) {
+        warmPrefetches();
+    }
+
+    return true;
+}
+
+void
+BaseCache::warmPrefetches()
+{
+    while (PacketPtr pf_pkt = prefetcher->getPacket()) {
+        if (tags->findBlock(pf_pkt->getAddr(), pf_pkt->isSecure())) {
+            prefetcher->pfHitInCache();
+            delete pf_pkt;
+            continue;
+        }
+
+        assert(pf_pkt->req->requestorId() < system->maxRequestors());
+        stats.cmdStats(pf_pkt).mshrMisses[pf_pkt->req->requestorId()]++;
+
+        requestMemBackdoor(pf_pkt->getBlockAddr(blkSize));
+        PacketPtr bus_pkt = createMissPacket(pf_pkt, nullptr, false, false);
+        assert(bus_pkt);
+        memSidePort.sendAtomic(bus_pkt);
+
+        PacketList writebacks;
+        if (!bus_pkt->isError()) {
+            CacheBlk *blk = handleFill(bus_pkt, nullptr, writebacks, true);
+            if (blk == tempBlock) {
+                // no room for the prefetch, drop it right away
+                evictBlock(blk, writebacks);
+            } else {
+                blk->setPrefetched();
+            }
+        }
+        delete bus_pkt;
+        delete pf_pkt;
+
+        doWritebacksAtomic(writebacks);
+    }
+}
+
 void
 BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
 {
@@ -1704,6 +1794,90 @@ BaseCache::evictBlock(CacheBlk *blk, PacketList &writebacks)
     }
 }
 
+void
+BaseCache::requestMemBackdoor(Addr blk_addr)
+{
+    if (!useMemBackdoor || !system->isAtomicMode() ||
+            memBackdoors.contains(blk_addr) != memBackdoors.end()) {
+        return;
+    }
+
+    MemBackdoorPtr bd = nullptr;
+    memSidePort.sendMemBackdoorReq(
+        MemBackdoorReq(RangeSize(blk_addr, blkSize),
+                       MemBackdoor::Flags(MemBackdoor::Readable |
+                                          MemBackdoor::Writeable)),
+        bd);
+    if (!bd || !bd->readable() || !bd->writeable() ||
+            memBackdoors.insert(bd->range(), bd) == memBackdoors.end()) {
+        return;
+    }
+
+    DPRINTF(Cache, "%s: got memory backdoor for %s\n", __func__,
+            bd->range().to_string());
+
+    // Invalidation callback which finds this backdoor and removes it.
+    bd->addInvalidationCallback([this](const MemBackdoor &backdoor) {
+        for (auto it = memBackdoors.begin(); it != memBackdoors.end(); it++) {
+            if (it->second == &backdoor) {
+                memBackdoors.erase(it);
+                return;
+            }
+        }
+        panic("Got invalidation for unknown memory backdoor.");
+    });
+}
+
+uint8_t *
+BaseCache::memBackdoorData(Addr blk_addr) const
+{
+    if (!useMemBackdoor || !system->isAtomicMode())
+        return nullptr;
+
+    auto it = memBackdoors.contains(RangeSize(blk_addr, blkSize));
+    if (it == memBackdoors.end())
+        return nullptr;
+
+    const MemBackdoor *bd = it->second;
+    return bd->ptr() + (blk_addr - bd->range().start());
+}
+
+void
+BaseCache::allocateMissData(PacketPtr pkt) const
+{
+    uint8_t *data = pkt->isRead() ? memBackdoorData(pkt->getAddr()) :
+        nullptr;
+    if (data) {
+        pkt->dataStatic(data);
+        pkt->setBackdoorData();
+    } else {
+        pkt->allocate();
+    }
+}
+
+void
+BaseCache::setWritebackData(PacketPtr pkt, CacheBlk *blk)
+{
+    // The memory drops the data of clean writebacks, and the block may
+    // hold data that is newer than the memory if a cache above owns it,
+    // so clean writebacks are not written through the backdoor. They
+    // carry a copy of the block instead of pointing at the memory, as
+    // the caches on the way may keep their data.
+    uint8_t *data = nullptr;
+    if (pkt->cmd != MemCmd::WritebackClean) {
+        requestMemBackdoor(pkt->getAddr());
+        data = memBackdoorData(pkt->getAddr());
+    }
+    if (data) {
+        std::memcpy(data, blk->data, blkSize);
+        pkt->dataStatic(data);
+        pkt->setBackdoorData();
+    } else {
+        pkt->allocate();
+        pkt->setDataFromBlock(blk->data, blkSize);
+    }
+}
+
 PacketPtr
 BaseCache::writebackBlk(CacheBlk *blk)
 {
@@ -1742,8 +1916,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
     // make sure the block is not marked dirty
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
-    pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    setWritebackData(pkt, blk);
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -1787,8 +1960,7 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     // make sure the block is not marked dirty
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
-    pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    setWritebackData(pkt, blk);
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -51,6 +51,7 @@
 #include <string>
 
 #include "base/addr_range.hh"
+#include "base/addr_range_map.hh"
 #include "base/compiler.hh"
 #include "base/statistics.hh"
 #include "base/trace.hh"
@@ -58,6 +59,7 @@
 #include "debug/Cache.hh"
 #include "debug/CachePort.hh"
 #include "enums/Clusivity.hh"
+#include "mem/backdoor.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/cache_probe_arg.hh"
 #include "mem/cache/compressors/base.hh"
@@ -601,6 +603,24 @@ class BaseCache : public ClockedObject
      */
     virtual Tick recvAtomic(PacketPtr pkt);
 
+    /**
+     * Warm-only access. Services a plain demand read or write that hits
+     * in the cache by touching the tags, the replacement state and the
+     * prefetcher, without modelling any latency. Everything else, misses
+     * included, must go through the regular atomic path so that
+     * coherence is maintained.
+     *
+     * @param pkt The request to perform.
+     * @return True if the access was satisfied.
+     */
+    bool warmAccess(PacketPtr pkt);
+
+    /**
+     * Drain the prefetcher queue during a warm-only access, filling the
+     * prefetched blocks atomically.
+     */
+    void warmPrefetches();
+
     /**
      * Snoop for the provided request in the cache and return the estimated
      * time taken.
@@ -680,6 +700,23 @@ class BaseCache : public ClockedObject
      */
     const bool writebackClean;
 
+    /**
+     * In atomic mode, fill blocks from and write them back to the memory
+     * below through memory backdoors when it provides them. The packets
+     * then point at the memory instead of carrying a copy of the block.
+     * Atomic accesses reach the memory as they are made, so the memory
+     * sees the data in the order of the accesses. Timing mode, in which
+     * packets are queued on their way to the memory, always copies:
+     * there a write through the backdoor could overtake a queued DMA
+     * write, and the backdoors would also have to be dropped on LL/SC
+     * and on range changes. Clean writebacks carry a copy of the block,
+     * as the memory ignores their data.
+     */
+    const bool useMemBackdoor;
+
+    /** Backdoors to the memory below, in the memory address space. */
+    AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
+
     /**
      * Writebacks from the tempBlock, resulting on the response path
      * in atomic mode, must happen after the call to recvAtomic has
@@ -833,6 +870,42 @@ class BaseCache : public ClockedObject
      */
     void invalidateBlock(CacheBlk *blk);
 
+    /**
+     * Request a backdoor to a block from the memory below, unless one is
+     * already known.
+     *
+     * @param blk_addr Address of the block.
+     */
+    void requestMemBackdoor(Addr blk_addr);
+
+    /**
+     * Get the location of a block in the backing store of the memory
+     * below.
+     *
+     * @param blk_addr Address of the block.
+     * @return The host address of the block, or nullptr if the block
+     * has to be carried by the packets.
+     */
+    uint8_t *memBackdoorData(Addr blk_addr) const;
+
+    /**
+     * Provide the data of a packet fetching a block, pointing at the
+     * memory below when possible.
+     *
+     * @param pkt Packet sent to the memory below.
+     */
+    void allocateMissData(PacketPtr pkt) const;
+
+    /**
+     * Provide the data of a packet writing a block back. When the
+     * memory below provides a backdoor, the block is written to memory
+     * right away and the packet points at it.
+     *
+     * @param pkt Writeback packet.
+     * @param blk The block written back.
+     */
+    void setWritebackData(PacketPtr pkt, CacheBlk *blk);
+
     /**
      * Create a writeback request for the given block.
      *
@@ -964,6 +1037,13 @@ class BaseCache : public ClockedObject
      */
     const bool moveContractions;
 
+    /**
+     * Use the warm-only path for atomic accesses: hits skip the latency
+     * calculation and the prefetcher is trained and issued as it would
+     * be in timing mode. Meant for warming caches during fast-forward.
+     */
+    const bool warmOnly;
+
     /**
      * Bit vector of the blocking reasons for the access path.
      * @sa #BlockedCause
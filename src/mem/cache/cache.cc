@@ -567,7 +567,7 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
     // the packet should be block aligned
     assert(pkt->getAddr() == pkt->getBlockAddr(blkSize));
 
-    pkt->allocate();
+    allocateMissData(pkt);
     DPRINTF(Cache, "%s: created %s from %s\n", __func__, pkt->print(),
             cpu_pkt->print());
     return pkt;
@@ -595,6 +595,8 @@ Cache::handleAtomicReqMiss(PacketPtr pkt, CacheBlk *&blk,
 
     // only misses left
 
+    if (!pkt->req->isUncacheable())
+        requestMemBackdoor(pkt->getBlockAddr(blkSize));
     PacketPtr bus_pkt = createMissPacket(pkt, blk, pkt->needsWritable(),
                                          pkt->isWholeLineWrite(blkSize));
 
@@ -1230,8 +1232,11 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
             pkt->makeAtomicResponse();
             // packets such as upgrades do not actually have any data
             // payload
-            if (pkt->hasData())
+            if (pkt->hasData()) {
+                // a fill pointing at the memory must not write there
+                pkt->detachBackdoorData();
                 pkt->setDataFromBlock(blk->data, blkSize);
+            }
         }
 
         // When a block is compressed, it must first be decompressed before
@@ -160,7 +160,7 @@ NoncoherentCache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
     // the packet should be block aligned
     assert(pkt->getAddr() == pkt->getBlockAddr(blkSize));
 
-    pkt->allocate();
+    allocateMissData(pkt);
     DPRINTF(Cache, "%s created %s from %s\n", __func__, pkt->print(),
             cpu_pkt->print());
     return pkt;
@@ -171,6 +171,8 @@ Cycles
 NoncoherentCache::handleAtomicReqMiss(PacketPtr pkt, CacheBlk *&blk,
                                       PacketList &writebacks)
 {
+    if (!pkt->req->isUncacheable())
+        requestMemBackdoor(pkt->getBlockAddr(blkSize));
     PacketPtr bus_pkt = createMissPacket(pkt, blk, true,
                                          pkt->isWholeLineWrite(blkSize));
     DPRINTF(Cache, "Sending an atomic %s\n", bus_pkt->print());
@@ -57,6 +57,7 @@ AccessMapPatternMatching::AccessMapPatternMatching(
                      p.access_map_table_replacement_policy,
                      p.access_map_table_indexing_policy,
                      AccessMapEntry(hotZoneSize / blkSize)),
+      zoneStates(3 * (hotZoneSize / blkSize)),
       numGoodPrefetches(0), numTotalPrefetches(0), numRawCacheMisses(0),
       numRawCacheHits(0), degree(startDegree), usefulDegree(startDegree),
       epochEvent([this]{ processEpochEvent(); }, name())
@@ -188,7 +189,7 @@ AccessMapPatternMatching::calculatePrefetch(const Base::PrefetchInfo &pfi,
      * With this, we avoid doing boundaries checking in the loop that looks
      * for prefetch candidates, mark out of range positions with AM_INVALID
      */
-    std::vector<AccessMapState> states(3 * lines_per_zone);
+    std::vector<AccessMapState> &states = zoneStates;
     for (unsigned idx = 0; idx < lines_per_zone; idx += 1) {
         states[idx] =
             am_entry_prev != nullptr ? am_entry_prev->states[idx] : AM_INVALID;
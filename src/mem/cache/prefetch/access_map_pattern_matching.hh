@@ -111,6 +111,12 @@ class AccessMapPatternMatching : public ClockedObject
     /** Access map table */
     AssociativeSet<AccessMapEntry> accessMapTable;
 
+    /**
+     * Contiguous copy of the states of the previous, current and next hot
+     * zones, reused across calls to calculatePrefetch()
+     */
+    std::vector<AccessMapState> zoneStates;
+
     /**
      * Number of good prefetches
      * - State transitions from PREFETCH to ACCESS
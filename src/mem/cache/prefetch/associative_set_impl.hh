@@ -52,9 +52,9 @@ Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
     Addr tag = indexingPolicy->extractTag(addr);
-    auto candidates = indexingPolicy->getPossibleEntries(addr);
+    indexingPolicy->getPossibleEntries(addr, this->candidates);
 
-    for (auto candidate : candidates) {
+    for (auto candidate : this->candidates) {
         Entry* entry = static_cast<Entry*>(candidate);
         if (entry->matchTag(tag, is_secure)) {
             return entry;
@@ -62,6 +62,7 @@ BOP::BOP(const BOPPrefetcherParams &p)
 
     rrLeft.resize(rrEntries);
     rrRight.resize(rrEntries);
+    rrZeroEntries = 2 * rrEntries;
 
     // Following the paper implementation, a list with the specified number
     // of offsets which are of the form 2^i * 3^j * 5^k with i,j,k >= 0
@@ -124,14 +125,15 @@ BOP::hash(Addr addr, unsigned int way) const
 void
 BOP::insertIntoRR(Addr addr, unsigned int way)
 {
-    switch (way) {
-        case RRWay::Left:
-            rrLeft[hash(addr, RRWay::Left)] = addr;
-            break;
-        case RRWay::Right:
-            rrRight[hash(addr, RRWay::Right)] = addr;
-            break;
+    Addr &entry = (way == RRWay::Left) ? rrLeft[hash(addr, way)] :
+                                         rrRight[hash(addr, way)];
+
+    if (entry == 0 && addr != 0) {
+        rrZeroEntries--;
+    } else if (entry != 0 && addr == 0) {
+        rrZeroEntries++;
     }
+    entry = addr;
 }
 
 void
@@ -169,19 +171,12 @@ BOP::tag(Addr addr) const
 bool
 BOP::testRR(Addr addr) const
 {
-    for (auto& it : rrLeft) {
-        if (it == addr) {
-            return true;
-        }
-    }
-
-    for (auto& it : rrRight) {
-        if (it == addr) {
-            return true;
-        }
+    if (addr == 0) {
+        return rrZeroEntries != 0;
     }
 
-    return false;
+    return rrLeft[hash(addr, RRWay::Left)] == addr ||
+           rrRight[hash(addr, RRWay::Right)] == addr;
 }
 
 void
@@ -74,6 +74,12 @@ class BOP : public Queued
         std::vector<Addr> rrLeft;
         std::vector<Addr> rrRight;
 
+        /** Number of RR entries (both ways) holding address zero. Addresses
+         *  are only ever stored at their hashed index, so a lookup only
+         *  needs to probe that index, except for zero, which also matches
+         *  every entry that was never written */
+        unsigned int rrZeroEntries;
+
         /** Structure to save the offset and the score */
         typedef std::pair<int16_t, uint8_t> OffsetListEntry;
         std::vector<OffsetListEntry> offsetsList;
@@ -196,15 +196,15 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
     }
 
     // Calculate prefetches given this access
-    std::vector<AddrPriority> addresses;
-    calculatePrefetch(pfi, addresses, cache);
+    pfCandidates.clear();
+    calculatePrefetch(pfi, pfCandidates, cache);
 
     // Get the maximu number of prefetches that we are allowed to generate
-    size_t max_pfs = getMaxPermittedPrefetches(addresses.size());
+    size_t max_pfs = getMaxPermittedPrefetches(pfCandidates.size());
 
     // Queue up generated prefetches
     size_t num_pfs = 0;
-    for (AddrPriority& addr_prio : addresses) {
+    for (AddrPriority& addr_prio : pfCandidates) {
 
         // Block align prefetch address
         addr_prio.first = blockAddress(addr_prio.first);
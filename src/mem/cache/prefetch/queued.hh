@@ -214,6 +214,13 @@ class Queued : public Base
 
   private:
 
+    /**
+     * Scratch buffer for the candidates generated by calculatePrefetch().
+     * It is cleared, not freed, between accesses so that notify() does not
+     * allocate once it has reached its steady-state capacity.
+     */
+    std::vector<AddrPriority> pfCandidates;
+
     /**
      * Adds a DeferredPacket to the specified queue
      * @param queue selected queue to use
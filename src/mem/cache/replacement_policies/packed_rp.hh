@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Compile-time specialised replacement policies operating on per-set
+ * packed metadata. They are used by PackedSetAssoc instead of the
+ * replacement_policy::Base objects, and make exactly the same decisions
+ * as the policy they mirror, so that a cache using them produces the same
+ * results. The difference is that the state of a whole set is stored
+ * inline, e.g. an 8-way tree PLRU fits in one byte, and no virtual call or
+ * shared_ptr dereference is needed to update it.
+ *
+ * Each policy provides a SetData type holding the state of one set and
+ * static touch(), reset(), invalidate() and getVictim() functions.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_RP_HH__
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+/** Mirrors LRU: one last touch tick per way. */
+template <unsigned Assoc>
+struct PackedLRU
+{
+    struct SetData
+    {
+        std::array<Tick, Assoc> lastTouchTick{};
+    };
+
+    static void
+    touch(SetData &set, unsigned way)
+    {
+        set.lastTouchTick[way] = curTick();
+    }
+
+    static void
+    reset(SetData &set, unsigned way)
+    {
+        set.lastTouchTick[way] = curTick();
+    }
+
+    static void
+    invalidate(SetData &set, unsigned way)
+    {
+        set.lastTouchTick[way] = Tick(0);
+    }
+
+    static unsigned
+    getVictim(const SetData &set)
+    {
+        // Ties go to the lowest way, as in LRU::getVictim()
+        unsigned victim = 0;
+        for (unsigned way = 1; way < Assoc; way++) {
+            if (set.lastTouchTick[way] < set.lastTouchTick[victim]) {
+                victim = way;
+            }
+        }
+        return victim;
+    }
+};
+
+/**
+ * Mirrors TreePLRU with num_leaves == Assoc: the Assoc - 1 tree nodes are
+ * the bits of a single integer, numbered as in TreePLRU (root is bit 0,
+ * the children of node i are nodes 2i + 1 and 2i + 2).
+ */
+template <unsigned Assoc>
+struct PackedTreePLRU
+{
+    static_assert(Assoc >= 2 && Assoc <= 64 && isPowerOf2(Assoc),
+                  "Tree PLRU needs a power of 2 number of ways");
+
+    using Bits = std::conditional_t<Assoc <= 8, uint8_t,
+                 std::conditional_t<Assoc <= 16, uint16_t,
+                 std::conditional_t<Assoc <= 32, uint32_t, uint64_t>>>;
+
+    struct SetData
+    {
+        Bits tree = 0;
+    };
+
+    /**
+     * Walk from the leaf of a way to the root, setting each node to point
+     * towards (towards = true) or away from the subtree we come from.
+     */
+    static void
+    update(SetData &set, unsigned way, bool towards)
+    {
+        unsigned index = way + Assoc - 1;
+        do {
+            const bool right = index % 2 == 0;
+            index = (index - 1) / 2;
+            if (right == towards) {
+                set.tree |= Bits(1) << index;
+            } else {
+                set.tree &= ~(Bits(1) << index);
+            }
+        } while (index != 0);
+    }
+
+    static void
+    touch(SetData &set, unsigned way)
+    {
+        update(set, way, false);
+    }
+
+    static void
+    reset(SetData &set, unsigned way)
+    {
+        update(set, way, false);
+    }
+
+    static void
+    invalidate(SetData &set, unsigned way)
+    {
+        update(set, way, true);
+    }
+
+    static unsigned
+    getVictim(const SetData &set)
+    {
+        unsigned index = 0;
+        while (index < Assoc - 1) {
+            index = (set.tree >> index) & 1 ? 2 * index + 2 : 2 * index + 1;
+        }
+        return index - (Assoc - 1);
+    }
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_RP_HH__
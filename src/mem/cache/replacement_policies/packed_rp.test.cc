@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/replacement_policies/packed_rp.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+// The global tick handler
+GTestTickHandler tickHandler;
+
+/** An 8-way tree PLRU set fits in a byte */
+TEST(PackedRPTest, TreePLRUSize)
+{
+    static_assert(sizeof(PackedTreePLRU<8>::SetData) == 1);
+    static_assert(sizeof(PackedTreePLRU<16>::SetData) == 2);
+}
+
+/** The LRU victim is the least recently touched way */
+TEST(PackedRPTest, LRUVictim)
+{
+    PackedLRU<4>::SetData set;
+    for (unsigned way = 0; way < 4; way++) {
+        tickHandler.setCurTick(10 + way);
+        PackedLRU<4>::reset(set, way);
+    }
+    EXPECT_EQ(PackedLRU<4>::getVictim(set), 0);
+
+    tickHandler.setCurTick(20);
+    PackedLRU<4>::touch(set, 0);
+    EXPECT_EQ(PackedLRU<4>::getVictim(set), 1);
+
+    PackedLRU<4>::invalidate(set, 3);
+    EXPECT_EQ(PackedLRU<4>::getVictim(set), 3);
+}
+
+/** LRU ties go to the lowest way */
+TEST(PackedRPTest, LRUTies)
+{
+    PackedLRU<8>::SetData set;
+    EXPECT_EQ(PackedLRU<8>::getVictim(set), 0);
+
+    tickHandler.setCurTick(5);
+    PackedLRU<8>::reset(set, 0);
+    PackedLRU<8>::reset(set, 1);
+    EXPECT_EQ(PackedLRU<8>::getVictim(set), 2);
+}
+
+/**
+ * The packed tree PLRU makes the same decisions as the node layout used by
+ * TreePLRU, for an arbitrary sequence of updates.
+ */
+TEST(PackedRPTest, TreePLRUMatchesTree)
+{
+    constexpr unsigned assoc = 8;
+    PackedTreePLRU<assoc>::SetData set;
+    std::vector<bool> tree(assoc - 1, false);
+
+    auto ref_update = [&](unsigned way, bool towards) {
+        unsigned index = way + assoc - 1;
+        do {
+            const bool right = index % 2 == 0;
+            index = (index - 1) / 2;
+            tree[index] = towards ? right : !right;
+        } while (index != 0);
+    };
+    auto ref_victim = [&]() {
+        unsigned index = 0;
+        while (index < assoc - 1) {
+            index = tree[index] ? 2 * index + 2 : 2 * index + 1;
+        }
+        return index - (assoc - 1);
+    };
+
+    unsigned seed = 1;
+    for (int i = 0; i < 1000; i++) {
+        seed = seed * 1103515245 + 12345;
+        const unsigned way = (seed >> 16) % assoc;
+        if ((seed >> 8) % 4 == 0) {
+            PackedTreePLRU<assoc>::invalidate(set, way);
+            ref_update(way, true);
+        } else {
+            PackedTreePLRU<assoc>::touch(set, way);
+            ref_update(way, false);
+        }
+        ASSERT_EQ(PackedTreePLRU<assoc>::getVictim(set), ref_victim());
+    }
+}
+
+/** Touching every way in order makes the first one the victim */
+TEST(PackedRPTest, TreePLRUVictim)
+{
+    PackedTreePLRU<4>::SetData set;
+    for (unsigned way = 0; way < 4; way++) {
+        PackedTreePLRU<4>::touch(set, way);
+    }
+    EXPECT_EQ(PackedTreePLRU<4>::getVictim(set), 0);
+
+    PackedTreePLRU<4>::invalidate(set, 2);
+    EXPECT_EQ(PackedTreePLRU<4>::getVictim(set), 2);
+}
@@ -207,6 +207,9 @@ class TreePLRU : public Base
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+
+    /** Number of leaves of each tree. */
+    uint64_t getNumLeaves() const { return numLeaves; }
 };
 
 } // namespace replacement_policy
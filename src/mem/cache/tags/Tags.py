@@ -148,3 +148,14 @@ class FALRU(BaseTags):
 
     # This tag uses its own embedded indexing
     indexing_policy = NULL
+
+
+class PackedSetAssoc(BaseSetAssoc):
+    type = "PackedSetAssoc"
+    cxx_header = "mem/cache/tags/packed_set_assoc.hh"
+    cxx_class = "gem5::PackedSetAssocBase"
+
+    # The C++ object is a specialisation picked by create() from the
+    # replacement policy (LRURP or TreePLRURP with one leaf per way) and
+    # the associativity (2, 4, 8 or 16). Only the SetAssociative indexing
+    # policy is supported, without partitioning.
@@ -85,11 +85,10 @@ BaseTags::findBlock(Addr addr, bool is_secure) const
     Addr tag = extractTag(addr);
 
     // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(addr);
+    indexingPolicy->getPossibleEntries(addr, possibleEntries);
 
     // Search for block
-    for (const auto& location : entries) {
+    for (const auto& location : possibleEntries) {
         CacheBlk* blk = static_cast<CacheBlk*>(location);
         if (blk->matchTag(tag, is_secure)) {
             return blk;
@@ -50,6 +50,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/logging.hh"
@@ -88,6 +89,12 @@ class BaseTags : public ClockedObject
     /** Indexing policy */
     BaseIndexingPolicy *indexingPolicy;
 
+    /**
+     * Buffer for the possible entries of the address being looked up,
+     * reused so that lookups do not allocate.
+     */
+    mutable std::vector<ReplaceableEntry*> possibleEntries;
+
     /** Partitioning manager */
     partitioning_policy::PartitionManager *partitionManager;
 
@@ -299,6 +306,21 @@ class BaseTags : public ClockedObject
      */
     virtual CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) = 0;
 
+    /**
+     * Update the replacement data of a block that was hit during a
+     * warm-only access. Unlike accessBlock() no latency is computed and
+     * the tag and data access stats are left untouched.
+     *
+     * @param blk The block that was hit.
+     * @param pkt The packet that hit on the block.
+     */
+    virtual void
+    warmBlock(CacheBlk *blk, const PacketPtr pkt)
+    {
+        Cycles lat;
+        accessBlock(pkt, lat);
+    }
+
     /**
      * Generate the tag from the given address.
      *
@@ -156,6 +156,13 @@ class BaseSetAssoc : public BaseTags
         return blk;
     }
 
+    void
+    warmBlock(CacheBlk *blk, const PacketPtr pkt) override
+    {
+        blk->increaseRefCount();
+        replacementPolicy->touch(blk->replacementData, pkt);
+    }
+
     /**
      * Find replacement victim based on address. The list of evicted blocks
      * only contains the victim.
@@ -173,17 +180,18 @@ class BaseSetAssoc : public BaseTags
                          const uint64_t partition_id=0) override
     {
         // Get possible entries to be victimized
-        std::vector<ReplaceableEntry*> entries =
-            indexingPolicy->getPossibleEntries(addr);
+        indexingPolicy->getPossibleEntries(addr, possibleEntries);
 
         // Filter entries based on PartitionID
         if (partitionManager) {
-            partitionManager->filterByPartition(entries, partition_id);
+            partitionManager->filterByPartition(possibleEntries,
+                                                partition_id);
         }
 
         // Choose replacement victim from replacement candidates
-        CacheBlk* victim = entries.empty() ? nullptr :
-            static_cast<CacheBlk*>(replacementPolicy->getVictim(entries));
+        CacheBlk* victim = possibleEntries.empty() ? nullptr :
+            static_cast<CacheBlk*>(
+                replacementPolicy->getVictim(possibleEntries));
 
         // There is only one eviction for this replacement
         evict_blks.push_back(victim);
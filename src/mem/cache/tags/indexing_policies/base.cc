@@ -101,4 +101,12 @@ BaseIndexingPolicy::extractTag(const Addr addr) const
     return (addr >> tagShift);
 }
 
+std::vector<ReplaceableEntry*>
+BaseIndexingPolicy::getPossibleEntries(const Addr addr) const
+{
+    std::vector<ReplaceableEntry*> entries;
+    getPossibleEntries(addr, entries);
+    return entries;
+}
+
 } // namespace gem5
@@ -146,8 +146,19 @@ class BaseIndexingPolicy : public SimObject
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
-                                                                    const = 0;
+    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const;
+
+    /**
+     * Find all possible entries for insertion and replacement of an address,
+     * without allocating. The entries replace the contents of a buffer of
+     * the caller, which keeps its capacity between lookups, so only the
+     * first lookup with a given buffer may allocate.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param entries The buffer receiving the possible entries.
+     */
+    virtual void getPossibleEntries(const Addr addr,
+        std::vector<ReplaceableEntry*> &entries) const = 0;
 
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
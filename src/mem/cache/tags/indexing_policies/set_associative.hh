@@ -106,6 +106,8 @@ class SetAssociative : public BaseIndexingPolicy
      */
     ~SetAssociative() {};
 
+    using BaseIndexingPolicy::getPossibleEntries;
+
     /**
      * Find all possible entries for insertion and replacement of an address.
      * Should be called immediately before ReplacementPolicy's findVictim()
@@ -113,10 +115,10 @@ class SetAssociative : public BaseIndexingPolicy
      * Returns entries in all ways belonging to the set of the address.
      *
      * @param addr The addr to a find possible entries for.
-     * @return The possible entries.
+     * @param entries The buffer receiving the possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                     override;
+    void getPossibleEntries(const Addr addr,
+        std::vector<ReplaceableEntry*> &entries) const override;
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the compile-time specialised set associative tag store.
+ */
+
+#include "mem/cache/tags/packed_set_assoc.hh"
+
+#include <typeinfo>
+
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/replacement_policies/tree_plru_rp.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+
+namespace gem5
+{
+
+PackedSetAssocBase::PackedSetAssocBase(const Params &p)
+    : BaseSetAssoc(p),
+      numSets(p.size / (p.entry_size * p.assoc)),
+      setShift(floorLog2(p.entry_size)), setMask(numSets - 1),
+      tagShift(setShift + floorLog2(numSets))
+{
+    fatal_if(!dynamic_cast<SetAssociative *>(p.indexing_policy),
+             "%s: requires the SetAssociative indexing policy", name());
+    fatal_if(p.partitioning_manager,
+             "%s: cache partitioning is not supported", name());
+    fatal_if(!isPowerOf2(numSets), "%s: # of sets must be non-zero and a "
+             "power of 2", name());
+}
+
+void
+PackedSetAssocBase::tagsInit()
+{
+    BaseSetAssoc::tagsInit();
+
+    // Lookups index the blocks directly, so they must be laid out in the
+    // same order as the sets of the indexing policy
+    for (unsigned blk_index = 0; blk_index < numBlocks; blk_index++) {
+        const CacheBlk &blk = blks[blk_index];
+        fatal_if(blk.getSet() * allocAssoc + blk.getWay() != blk_index,
+                 "%s: the indexing policy geometry does not match the tags",
+                 name());
+    }
+}
+
+namespace
+{
+
+template <template <unsigned> class Policy>
+PackedSetAssocBase *
+createPacked(const PackedSetAssocParams &p)
+{
+    switch (p.assoc) {
+      case 2:
+        return new PackedSetAssoc<Policy<2>, 2>(p);
+      case 4:
+        return new PackedSetAssoc<Policy<4>, 4>(p);
+      case 8:
+        return new PackedSetAssoc<Policy<8>, 8>(p);
+      case 16:
+        return new PackedSetAssoc<Policy<16>, 16>(p);
+      default:
+        fatal("%s: no specialisation for %d ways", p.name, p.assoc);
+    }
+}
+
+} // anonymous namespace
+
+} // namespace gem5
+
+gem5::PackedSetAssocBase *
+gem5::PackedSetAssocParams::create() const
+{
+    namespace rp = gem5::replacement_policy;
+
+    // Policies derived from LRU (e.g. BIP) behave differently, so the
+    // exact type must match. The packed tree PLRU has one leaf per way.
+    const std::type_info &type = typeid(*replacement_policy);
+    if (type == typeid(rp::LRU)) {
+        return createPacked<rp::PackedLRU>(*this);
+    } else if (type == typeid(rp::TreePLRU)) {
+        const auto *plru =
+            static_cast<const rp::TreePLRU *>(replacement_policy);
+        fatal_if(plru->getNumLeaves() != (uint64_t)assoc,
+                 "%s: the tree PLRU must have one leaf per way, it has %d "
+                 "leaves for %d ways", name, plru->getNumLeaves(), assoc);
+        return createPacked<rp::PackedTreePLRU>(*this);
+    } else {
+        fatal("%s: no packed version of replacement policy %s", name,
+              replacement_policy->name());
+    }
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a set associative tag store specialised at compile time
+ * for its associativity and replacement policy.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PACKED_SET_ASSOC_HH__
+#define __MEM_CACHE_TAGS_PACKED_SET_ASSOC_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/replacement_policies/packed_rp.hh"
+#include "mem/cache/tags/base_set_assoc.hh"
+#include "mem/packet.hh"
+#include "params/PackedSetAssoc.hh"
+
+namespace gem5
+{
+
+/**
+ * Common base of the PackedSetAssoc specialisations. It cannot be built
+ * from its parameters directly: PackedSetAssocParams::create() picks the
+ * specialisation matching the replacement policy and associativity.
+ */
+class PackedSetAssocBase : public BaseSetAssoc
+{
+  public:
+    typedef PackedSetAssocParams Params;
+
+  protected:
+    PackedSetAssocBase(const Params &p);
+
+    /** Number of sets, and bits used to locate a block in them */
+    const unsigned numSets;
+    const int setShift;
+    const Addr setMask;
+    const int tagShift;
+
+    uint32_t
+    extractSet(Addr addr) const
+    {
+        return (addr >> setShift) & setMask;
+    }
+
+    /** Same as the SetAssociative indexing policy's extractTag() */
+    Addr
+    extractTagBits(Addr addr) const
+    {
+        return addr >> tagShift;
+    }
+
+  public:
+    void tagsInit() override;
+};
+
+/**
+ * Set associative tag store where the associativity and the replacement
+ * policy are template parameters. Blocks of a set are contiguous, so a
+ * lookup is a direct scan of the set without going through the indexing
+ * policy, and the replacement state of each set is kept packed next to
+ * the tags instead of in a shared_ptr per block. It only supports the
+ * SetAssociative indexing policy and no partitioning, and makes the same
+ * decisions as BaseSetAssoc with the mirrored replacement policy.
+ */
+template <class Policy, unsigned Assoc>
+class PackedSetAssoc : public PackedSetAssocBase
+{
+  protected:
+    /** Packed replacement state of each set */
+    std::vector<typename Policy::SetData> replData;
+
+    typename Policy::SetData &
+    setData(const CacheBlk *blk)
+    {
+        return replData[blk->getSet()];
+    }
+
+  public:
+    PackedSetAssoc(const Params &p)
+      : PackedSetAssocBase(p), replData(numSets)
+    {
+        fatal_if(p.assoc != Assoc, "%s: built for %d ways, got %d",
+                 name(), Assoc, p.assoc);
+    }
+
+    CacheBlk *
+    findBlock(Addr addr, bool is_secure) const override
+    {
+        const Addr tag = extractTagBits(addr);
+        const CacheBlk *set_blks = &blks[extractSet(addr) * Assoc];
+        for (unsigned way = 0; way < Assoc; way++) {
+            if (set_blks[way].matchTag(tag, is_secure)) {
+                return const_cast<CacheBlk *>(&set_blks[way]);
+            }
+        }
+        return nullptr;
+    }
+
+    CacheBlk *
+    accessBlock(const PacketPtr pkt, Cycles &lat) override
+    {
+        CacheBlk *blk = findBlock(pkt->getAddr(), pkt->isSecure());
+
+        // Same accounting as BaseSetAssoc::accessBlock()
+        stats.tagAccesses += allocAssoc;
+        if (sequentialAccess) {
+            if (blk != nullptr) {
+                stats.dataAccesses += 1;
+            }
+        } else {
+            stats.dataAccesses += allocAssoc;
+        }
+
+        if (blk != nullptr) {
+            blk->increaseRefCount();
+            Policy::touch(setData(blk), blk->getWay());
+        }
+
+        lat = lookupLatency;
+
+        return blk;
+    }
+
+    void
+    warmBlock(CacheBlk *blk, const PacketPtr pkt) override
+    {
+        blk->increaseRefCount();
+        Policy::touch(setData(blk), blk->getWay());
+    }
+
+    CacheBlk *
+    findVictim(Addr addr, const bool is_secure, const std::size_t size,
+               std::vector<CacheBlk*> &evict_blks,
+               const uint64_t partition_id=0) override
+    {
+        const uint32_t set = extractSet(addr);
+        CacheBlk *victim =
+            &blks[set * Assoc + Policy::getVictim(replData[set])];
+
+        // There is only one eviction for this replacement
+        evict_blks.push_back(victim);
+
+        return victim;
+    }
+
+    void
+    insertBlock(const PacketPtr pkt, CacheBlk *blk) override
+    {
+        BaseTags::insertBlock(pkt, blk);
+        stats.tagsInUse++;
+        Policy::reset(setData(blk), blk->getWay());
+    }
+
+    void
+    invalidate(CacheBlk *blk) override
+    {
+        BaseTags::invalidate(blk);
+        stats.tagsInUse--;
+        Policy::invalidate(setData(blk), blk->getWay());
+    }
+
+    void
+    moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk) override
+    {
+        BaseTags::moveBlock(src_blk, dest_blk);
+        Policy::invalidate(setData(src_blk), src_blk->getWay());
+        Policy::reset(setData(dest_blk), dest_blk->getWay());
+    }
+};
+
+} // namespace gem5
+
+#endif //__MEM_CACHE_TAGS_PACKED_SET_ASSOC_HH__
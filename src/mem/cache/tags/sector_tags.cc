@@ -190,6 +190,17 @@ SectorTags::accessBlock(const PacketPtr pkt, Cycles &lat)
     return blk;
 }
 
+void
+SectorTags::warmBlock(CacheBlk *blk, const PacketPtr pkt)
+{
+    blk->increaseRefCount();
+
+    // Replacement data is shared by the whole sector
+    const SectorBlk* sector_blk =
+        static_cast<SectorSubBlk*>(blk)->getSectorBlock();
+    replacementPolicy->touch(sector_blk->replacementData, pkt);
+}
+
 void
 SectorTags::insertBlock(const PacketPtr pkt, CacheBlk *blk)
 {
@@ -155,6 +155,8 @@ class SectorTags : public BaseTags
      */
     CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) override;
 
+    void warmBlock(CacheBlk *blk, const PacketPtr pkt) override;
+
     /**
      * Insert the new block into the cache and update replacement data.
      *
@@ -289,8 +289,17 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 pkt->clearWriteThrough();
             }
 
+            // remember where to route the normal response to, the
+            // responders below seeing the route
+            const bool push_route = expect_response && !is_express_snoop;
+            if (push_route)
+                routes.push(pkt, cpu_side_port_id);
+
             // since it is a normal request, attempt to send the packet
             success = memSidePorts[mem_side_port_id]->sendTimingReq(pkt);
+
+            if (!success && push_route)
+                routes.pop(pkt);
         } else {
             // no need to forward, turn this packet around and respond
             // directly
@@ -338,16 +347,17 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                          name(), maxOutstandingSnoopCheck);
             }
 
-            // remember where to route the normal response to
-            if (expect_response || expect_snoop_resp) {
+            // remember where to route the snoop response to
+            if (expect_snoop_resp) {
                 assert(routeTo.find(pkt->req) == routeTo.end());
                 routeTo[pkt->req] = cpu_side_port_id;
-
-                panic_if(routeTo.size() > maxRoutingTableSizeCheck,
-                         "%s: Routing table exceeds %d packets\n",
-                         name(), maxRoutingTableSizeCheck);
             }
 
+            panic_if(routeTo.size() + routes.size() >
+                     maxRoutingTableSizeCheck,
+                     "%s: Routing table exceeds %d packets\n",
+                     name(), maxRoutingTableSizeCheck);
+
             // update the layer state and schedule an idle event
             reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime);
         }
@@ -411,7 +421,8 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 assert(routeTo.find(pkt->req) == routeTo.end());
                 routeTo[pkt->req] = cpu_side_port_id;
 
-                panic_if(routeTo.size() > maxRoutingTableSizeCheck,
+                panic_if(routeTo.size() + routes.size() >
+                         maxRoutingTableSizeCheck,
                          "%s: Routing table exceeds %d packets\n",
                          name(), maxRoutingTableSizeCheck);
             }
@@ -450,9 +461,7 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     RequestPort *src_port = memSidePorts[mem_side_port_id];
 
     // determine the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID cpu_side_port_id = route_lookup->second;
+    const PortID cpu_side_port_id = routes.routeOf(pkt);
     assert(cpu_side_port_id != InvalidPortID);
     assert(cpu_side_port_id < respLayers.size());
 
@@ -490,12 +499,10 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     // any outstanding header delay
     Tick latency = pkt->headerDelay;
     pkt->headerDelay = 0;
+    routes.pop(pkt);
     cpuSidePorts[cpu_side_port_id]->schedTimingResp(pkt, curTick()
                                         + latency);
 
-    // remove the request from the routing table
-    routeTo.erase(route_lookup);
-
     respLayers[cpu_side_port_id]->succeededTiming(packetFinishTime);
 
     // stats updates
@@ -143,6 +143,10 @@ NoncoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     const bool expect_response = pkt->needsResponse() &&
         !pkt->cacheResponding();
 
+    // remember where to route the response to
+    if (expect_response)
+        routes.push(pkt, cpu_side_port_id);
+
     // since it is a normal request, attempt to send the packet
     bool success = memSidePorts[mem_side_port_id]->sendTimingReq(pkt);
 
@@ -150,6 +154,9 @@ NoncoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
         DPRINTF(NoncoherentXBar, "recvTimingReq: src %s %s 0x%x RETRY\n",
                 src_port->name(), pkt->cmdString(), pkt->getAddr());
 
+        if (expect_response)
+            routes.pop(pkt);
+
         // restore the header delay as it is additive
         pkt->headerDelay = old_header_delay;
 
@@ -160,12 +167,6 @@ NoncoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
         return false;
     }
 
-    // remember where to route the response to
-    if (expect_response) {
-        assert(routeTo.find(pkt->req) == routeTo.end());
-        routeTo[pkt->req] = cpu_side_port_id;
-    }
-
     reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime);
 
     // stats updates
@@ -183,9 +184,7 @@ NoncoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     RequestPort *src_port = memSidePorts[mem_side_port_id];
 
     // determine the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID cpu_side_port_id = route_lookup->second;
+    const PortID cpu_side_port_id = routes.routeOf(pkt);
     assert(cpu_side_port_id != InvalidPortID);
     assert(cpu_side_port_id < respLayers.size());
 
@@ -218,12 +217,10 @@ NoncoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     // any outstanding latency
     Tick latency = pkt->headerDelay;
     pkt->headerDelay = 0;
+    routes.pop(pkt);
     cpuSidePorts[cpu_side_port_id]->schedTimingResp(pkt,
                                         curTick() + latency);
 
-    // remove the request from the routing table
-    routeTo.erase(route_lookup);
-
     respLayers[cpu_side_port_id]->succeededTiming(packetFinishTime);
 
     // stats updates
@@ -360,7 +360,12 @@ class Packet : public Printable, public Extensible<Packet>
 
         // Signal block present to squash prefetch and cache evict packets
         // through express snoop flag
-        BLOCK_CACHED          = 0x00010000
+        BLOCK_CACHED          = 0x00010000,
+
+        /// The data pointer points at the backing store of the memory
+        /// the packet is going to, which the sender reads or wrote
+        /// through a backdoor, so the memory only models the timing.
+        BACKDOOR_DATA         = 0x00020000
     };
 
     Flags flags;
@@ -760,6 +765,34 @@ class Packet : public Printable, public Extensible<Packet>
     bool isBlockCached() const     { return flags.isSet(BLOCK_CACHED); }
     void clearBlockCached()        { flags.clear(BLOCK_CACHED); }
 
+    /**
+     * Mark a packet whose data pointer was set with dataStatic() to the
+     * backing store of the memory it is going to. The memory does not
+     * copy the data, and the flag is not copied with the packet.
+     */
+    void
+    setBackdoorData()
+    {
+        assert(flags.isSet(STATIC_DATA));
+        flags.set(BACKDOOR_DATA);
+    }
+    bool hasBackdoorData() const   { return flags.isSet(BACKDOOR_DATA); }
+
+    /**
+     * Give a packet pointing at the backing store of a memory a buffer
+     * of its own, so that a responder other than the memory does not
+     * write its data to the memory.
+     */
+    void
+    detachBackdoorData()
+    {
+        if (!hasBackdoorData())
+            return;
+        flags.clear(STATIC_DATA|BACKDOOR_DATA);
+        data = nullptr;
+        allocate();
+    }
+
     /**
      * QoS Value getter
      * Returns 0 if QoS value was never set (constructor default).
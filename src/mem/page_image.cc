@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the sparse, deduplicated memory images.
+ */
+
+#include "mem/page_image.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+/**
+ * Run a function over the ranges [begin, end) of [0, n) given to each of
+ * up to threads host threads.
+ */
+void
+parallelFor(unsigned threads, uint64_t n,
+            const std::function<void(uint64_t, uint64_t)> &func)
+{
+    threads = std::max(1u, (unsigned)std::min<uint64_t>(threads, n));
+    if (threads == 1) {
+        func(0, n);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    const uint64_t per_thread = divCeil(n, (uint64_t)threads);
+    for (uint64_t begin = 0; begin < n; begin += per_thread)
+        workers.emplace_back(func, begin, std::min(n, begin + per_thread));
+    for (auto &worker : workers)
+        worker.join();
+}
+
+/** Hash of a page, 0 if and only if the page is full of zeros. */
+uint64_t
+hashPage(const uint8_t *page, uint64_t page_size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint64_t bits = 0;
+    for (uint64_t i = 0; i < page_size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, page + i, sizeof(word));
+        bits |= word;
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    if (!bits)
+        return 0;
+    return hash ? hash : 1;
+}
+
+void
+writeAll(int fd, const void *buf, uint64_t size, uint64_t offset,
+         const std::string &path)
+{
+    const uint8_t *data = (const uint8_t *)buf;
+    while (size) {
+        const ssize_t written = pwrite(fd, data, size, offset);
+        if (written < 0 && errno == EINTR)
+            continue;
+        fatal_if(written <= 0, "Write failed on memory image '%s': %s\n",
+                 path, strerror(errno));
+        data += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+void
+readAll(int fd, void *buf, uint64_t size, uint64_t offset,
+        const std::string &path)
+{
+    uint8_t *data = (uint8_t *)buf;
+    while (size) {
+        const ssize_t bytes = pread(fd, data, size, offset);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        fatal_if(bytes <= 0, "Read failed on memory image '%s'\n", path);
+        data += bytes;
+        size -= bytes;
+        offset += bytes;
+    }
+}
+
+/** Number of stored pages compressed at a time. */
+constexpr uint64_t compressBatch = 4096;
+
+} // anonymous namespace
+
+void
+PageImage::write(const std::string &path, const uint8_t *pmem,
+                 uint64_t size, uint64_t page_size, bool compress,
+                 unsigned threads, const std::vector<bool> &populated,
+                 uint64_t chunk_size)
+{
+    fatal_if(!page_size || page_size % sizeof(uint64_t) ||
+             size % page_size,
+             "Memory of %d bytes can't be imaged in pages of %d bytes\n",
+             size, page_size);
+    fatal_if(!populated.empty() &&
+             (!chunk_size || chunk_size % page_size ||
+              populated.size() < divCeil(size, chunk_size)),
+             "Bad populated chunks of %d bytes for a memory image\n",
+             chunk_size);
+
+    const uint64_t num_pages = size / page_size;
+
+    // The pages of the chunks which were never populated are zero pages,
+    // reading them would populate them
+    std::vector<uint64_t> hashes(num_pages);
+    parallelFor(threads, num_pages, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t p = begin; p < end; p++) {
+            if (populated.empty() ||
+                    populated[p * page_size / chunk_size]) {
+                hashes[p] = hashPage(pmem + p * page_size, page_size);
+            }
+        }
+    });
+
+    // Pages with equal hashes are compared, pages colliding with a
+    // different one being stored separately
+    std::vector<uint64_t> index(num_pages, 0);
+    std::vector<uint64_t> stored;
+    std::unordered_map<uint64_t, uint64_t> by_hash;
+    for (uint64_t p = 0; p < num_pages; p++) {
+        if (!hashes[p])
+            continue;
+        auto [it, inserted] = by_hash.emplace(hashes[p], stored.size());
+        if (!inserted &&
+                std::memcmp(pmem + stored[it->second] * page_size,
+                            pmem + p * page_size, page_size) == 0) {
+            index[p] = it->second + 1;
+            continue;
+        }
+        index[p] = stored.size() + 1;
+        stored.push_back(p);
+    }
+    hashes.clear();
+    hashes.shrink_to_fit();
+
+    const std::string tmp_path = path + ".tmp";
+    const int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                        0666);
+    fatal_if(fd < 0, "Can't open memory image '%s': %s\n", tmp_path,
+             strerror(errno));
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.pageSize = page_size;
+    header.numPages = num_pages;
+    header.numStored = stored.size();
+    header.compressed = compress;
+    writeAll(fd, &header, sizeof(header), 0, tmp_path);
+
+    uint64_t offset = sizeof(header);
+    writeAll(fd, index.data(), num_pages * sizeof(uint64_t), offset,
+             tmp_path);
+    offset += num_pages * sizeof(uint64_t);
+
+    if (compress) {
+        // The offsets are written once all the pages are
+        std::vector<uint64_t> offsets(stored.size() + 1);
+        const uint64_t offsets_offset = offset;
+        offset += offsets.size() * sizeof(uint64_t);
+
+        std::vector<std::vector<uint8_t>> blobs(compressBatch);
+        for (uint64_t first = 0; first < stored.size();
+             first += compressBatch) {
+            const uint64_t count =
+                std::min(compressBatch, stored.size() - first);
+            parallelFor(threads, count, [&](uint64_t begin, uint64_t end) {
+                for (uint64_t i = begin; i < end; i++) {
+                    auto &blob = blobs[i];
+                    uLongf blob_size = compressBound(page_size);
+                    blob.resize(blob_size);
+                    const int ret = compress2(blob.data(), &blob_size,
+                        pmem + stored[first + i] * page_size, page_size,
+                        Z_BEST_SPEED);
+                    panic_if(ret != Z_OK, "Page compression failed\n");
+                    blob.resize(blob_size);
+                }
+            });
+            for (uint64_t i = 0; i < count; i++) {
+                offsets[first + i] = offset;
+                writeAll(fd, blobs[i].data(), blobs[i].size(), offset,
+                         tmp_path);
+                offset += blobs[i].size();
+            }
+        }
+        offsets.back() = offset;
+        writeAll(fd, offsets.data(), offsets.size() * sizeof(uint64_t),
+                 offsets_offset, tmp_path);
+    } else {
+        // Write the runs of pages stored next to each other at once
+        const uint64_t data_offset = roundUp(offset, page_size);
+        for (uint64_t first = 0; first < stored.size();) {
+            uint64_t count = 1;
+            while (first + count < stored.size() &&
+                   stored[first + count] == stored[first] + count) {
+                count++;
+            }
+            writeAll(fd, pmem + stored[first] * page_size,
+                     count * page_size, data_offset + first * page_size,
+                     tmp_path);
+            first += count;
+        }
+        fatal_if(ftruncate(fd, data_offset + stored.size() * page_size),
+                 "Can't resize memory image '%s'\n", tmp_path);
+    }
+
+    fatal_if(close(fd), "Close failed on memory image '%s'\n", tmp_path);
+    fatal_if(rename(tmp_path.c_str(), path.c_str()),
+             "Can't rename memory image '%s': %s\n", tmp_path,
+             strerror(errno));
+}
+
+uint64_t
+PageImage::read(const std::string &path, uint8_t *pmem, uint64_t size,
+                bool lazy, unsigned threads)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open memory image '%s': %s\n", path,
+             strerror(errno));
+
+    Header header;
+    readAll(fd, &header, sizeof(header), 0, path);
+    fatal_if(std::memcmp(header.magic, magic, sizeof(magic)),
+             "'%s' is not a memory image\n", path);
+    fatal_if(header.version != version,
+             "Unsupported version %d of memory image '%s'\n",
+             header.version, path);
+
+    const uint64_t page_size = header.pageSize;
+    const uint64_t num_pages = header.numPages;
+    fatal_if(num_pages * page_size != size,
+             "Memory size has changed! Saw %lld, expected %lld\n",
+             num_pages * page_size, size);
+
+    uint64_t offset = sizeof(header);
+    std::vector<uint64_t> index(num_pages);
+    readAll(fd, index.data(), num_pages * sizeof(uint64_t), offset, path);
+    offset += num_pages * sizeof(uint64_t);
+
+    for (auto entry : index) {
+        fatal_if(entry > header.numStored,
+                 "Corrupted memory image '%s'\n", path);
+    }
+
+    uint64_t mapped = 0;
+
+    if (header.compressed) {
+        std::vector<uint64_t> offsets(header.numStored + 1);
+        readAll(fd, offsets.data(), offsets.size() * sizeof(uint64_t),
+                offset, path);
+
+        // Each stored page is decompressed into the first page holding
+        // it, and copied to the others once they all are
+        std::vector<uint64_t> first_page(header.numStored);
+        std::vector<bool> is_first(num_pages, false);
+        for (uint64_t p = 0, next = 1; p < num_pages; p++) {
+            if (index[p] == next) {
+                first_page[next - 1] = p;
+                is_first[p] = true;
+                next++;
+            }
+        }
+
+        parallelFor(threads, header.numStored,
+                    [&](uint64_t begin, uint64_t end) {
+            std::vector<uint8_t> blob;
+            for (uint64_t i = begin; i < end; i++) {
+                fatal_if(offsets[i + 1] < offsets[i],
+                         "Corrupted memory image '%s'\n", path);
+                blob.resize(offsets[i + 1] - offsets[i]);
+                readAll(fd, blob.data(), blob.size(), offsets[i], path);
+                uLongf page_bytes = page_size;
+                const int ret = uncompress(pmem + first_page[i] * page_size,
+                                           &page_bytes, blob.data(),
+                                           blob.size());
+                fatal_if(ret != Z_OK || page_bytes != page_size,
+                         "Corrupted memory image '%s'\n", path);
+            }
+        });
+
+        parallelFor(threads, num_pages, [&](uint64_t begin, uint64_t end) {
+            for (uint64_t p = begin; p < end; p++) {
+                if (index[p] && !is_first[p]) {
+                    std::memcpy(pmem + p * page_size,
+                                pmem + first_page[index[p] - 1] * page_size,
+                                page_size);
+                }
+            }
+        });
+    } else {
+        const uint64_t data_offset = roundUp(offset, page_size);
+
+        // Runs of pages stored next to each other
+        struct Run
+        {
+            uint64_t page;
+            uint64_t stored;
+            uint64_t count;
+        };
+        std::vector<Run> runs;
+        for (uint64_t p = 0; p < num_pages; p++) {
+            if (!index[p])
+                continue;
+            if (!runs.empty() &&
+                    runs.back().page + runs.back().count == p &&
+                    runs.back().stored + runs.back().count == index[p] - 1) {
+                runs.back().count++;
+            } else {
+                runs.push_back({p, index[p] - 1, 1});
+            }
+        }
+
+        const long host_page_size = sysconf(_SC_PAGESIZE);
+        lazy = lazy && page_size % host_page_size == 0 &&
+            (uintptr_t)pmem % host_page_size == 0;
+
+        // Keep clear of the limit on the number of mappings, mapping
+        // the longest runs only if there are too many
+        const uint64_t min_run =
+            runs.size() > maxMappings ? minMappedRun : 1;
+        uint64_t mappings = 0;
+        std::vector<Run> copied;
+        for (const auto &run : runs) {
+            if (!lazy || run.count < min_run || mappings == maxMappings) {
+                copied.push_back(run);
+                continue;
+            }
+            void *addr = mmap(pmem + run.page * page_size,
+                              run.count * page_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_FIXED, fd,
+                              data_offset + run.stored * page_size);
+            fatal_if(addr == MAP_FAILED,
+                     "Can't map memory image '%s': %s\n", path,
+                     strerror(errno));
+            mappings++;
+            mapped += run.count;
+        }
+
+        parallelFor(threads, copied.size(),
+                    [&](uint64_t begin, uint64_t end) {
+            for (uint64_t i = begin; i < end; i++) {
+                readAll(fd, pmem + copied[i].page * page_size,
+                        copied[i].count * page_size,
+                        data_offset + copied[i].stored * page_size, path);
+            }
+        });
+    }
+
+    // The mappings keep the file open
+    close(fd);
+
+    return mapped;
+}
+
+void
+GzipImage::write(const std::string &path, const uint8_t *pmem,
+                 uint64_t size, const std::vector<bool> &populated,
+                 uint64_t chunk_size)
+{
+    fatal_if(!populated.empty() &&
+             (!chunk_size || chunk_size > INT_MAX ||
+              populated.size() < divCeil(size, chunk_size)),
+             "Bad populated chunks of %d bytes for a memory image\n",
+             chunk_size);
+
+    gzFile compressed_mem = gzopen(path.c_str(), "wb");
+    fatal_if(compressed_mem == NULL,
+             "Can't open physical memory checkpoint file '%s'\n", path);
+
+    // Write the chunks the host never populated from a zero buffer, so
+    // that reading them doesn't populate them. gzwrite fails if
+    // (int)len < 0 (gzwrite returns int).
+    const uint64_t pass_max = populated.empty() ? INT_MAX : chunk_size;
+    const std::vector<uint8_t> zeros(populated.empty() ? 0 : chunk_size, 0);
+
+    uint64_t pass_size = 0;
+    for (uint64_t written = 0; written < size; written += pass_size) {
+        pass_size = std::min(pass_max, size - written);
+        const uint8_t *data = populated.empty() ||
+            populated[written / chunk_size] ? pmem + written : zeros.data();
+
+        fatal_if(gzwrite(compressed_mem, data, (unsigned int)pass_size) !=
+                 (int)pass_size,
+                 "Write failed on physical memory checkpoint file '%s'\n",
+                 path);
+    }
+
+    // close the compressed stream and check that the exit status
+    // is zero
+    fatal_if(gzclose(compressed_mem),
+             "Close failed on physical memory checkpoint file '%s'\n",
+             path);
+}
+
+void
+GzipImage::read(const std::string &path, uint8_t *pmem, uint64_t size)
+{
+    const uint32_t chunk_size = 16384;
+
+    gzFile compressed_mem = gzopen(path.c_str(), "rb");
+    fatal_if(compressed_mem == NULL,
+             "Can't open physical memory checkpoint file '%s'", path);
+
+    uint64_t curr_size = 0;
+    std::vector<long> temp_page(chunk_size / sizeof(long));
+    while (curr_size < size) {
+        const int bytes_read = gzread(compressed_mem, temp_page.data(),
+                                      chunk_size);
+        fatal_if(bytes_read < 0,
+                 "Read failed on physical memory checkpoint file '%s'\n",
+                 path);
+        if (bytes_read == 0)
+            break;
+
+        assert(bytes_read % sizeof(long) == 0);
+        fatal_if(curr_size + bytes_read > size,
+                 "Physical memory checkpoint file '%s' is too large\n",
+                 path);
+
+        for (uint32_t x = 0; x < bytes_read / sizeof(long); x++) {
+            // Only copy bytes that are non-zero, so we don't give
+            // the VM system hell
+            if (temp_page[x] != 0) {
+                std::memcpy(pmem + curr_size + x * sizeof(long),
+                            &temp_page[x], sizeof(long));
+            }
+        }
+        curr_size += bytes_read;
+    }
+
+    fatal_if(gzclose(compressed_mem),
+             "Close failed on physical memory checkpoint file '%s'\n",
+             path);
+}
+
+} // namespace memory
+} // namespace gem5
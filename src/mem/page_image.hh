@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Images of memories, used to checkpoint the backing store.
+ */
+
+#ifndef __MEM_PAGE_IMAGE_HH__
+#define __MEM_PAGE_IMAGE_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * An image of a memory as a list of pages, in which the pages full of
+ * zeros are not stored, and pages with the same contents are stored
+ * once. The file is made of, in the host byte order:
+ *
+ * - a Header,
+ * - the index of the pages, one 64 bit entry per page of the memory, 0
+ *   for a zero page, or 1 + the number of the stored page holding its
+ *   contents,
+ * - for compressed images, the offsets in the file of the stored pages,
+ *   plus the offset of the end of the last one,
+ * - the stored pages, in the order of the first page of the memory
+ *   holding them. Pages which are not compressed are aligned to the page
+ *   size, so that they can be mapped from the file.
+ *
+ * The pages are hashed, and compressed, by several host threads.
+ */
+class PageImage
+{
+  public:
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t pageSize;
+        uint64_t numPages;
+        uint64_t numStored;
+        uint32_t compressed;
+        uint32_t reserved;
+    };
+
+    static constexpr char magic[8] = {'g', 'e', 'm', '5', 'P', 'M', 'E',
+                                      'M'};
+    static constexpr uint32_t version = 1;
+
+    /**
+     * Write the image of a memory. The image is written to a temporary
+     * file, renamed once complete, so that the memories mapping an
+     * image being overwritten are unaffected.
+     *
+     * @param path Path of the image file.
+     * @param pmem The memory.
+     * @param size Size of the memory, a multiple of the page size.
+     * @param page_size Size of the pages.
+     * @param compress Whether to compress the stored pages.
+     * @param threads Number of host threads to use.
+     * @param populated One bit per chunk of the memory, clear when the
+     *                  host never populated the chunk. The pages of these
+     *                  chunks are imaged as zero pages without being
+     *                  read. All the chunks are read if empty.
+     * @param chunk_size Size of the chunks, a multiple of the page size.
+     */
+    static void write(const std::string &path, const uint8_t *pmem,
+                      uint64_t size, uint64_t page_size, bool compress,
+                      unsigned threads,
+                      const std::vector<bool> &populated = {},
+                      uint64_t chunk_size = 0);
+
+    /**
+     * Restore the image of a memory into zero-filled memory.
+     *
+     * When lazy is set and the image is not compressed, the runs of
+     * stored pages are mapped privately from the file over the memory,
+     * so that the host only reads the pages which are accessed. The
+     * other pages are read or decompressed right away.
+     *
+     * @param path Path of the image file.
+     * @param pmem The memory, which must be zero-filled.
+     * @param size Size of the memory.
+     * @param lazy Whether pages may be mapped from the file. The memory
+     *             must then be a private mapping of host memory.
+     * @param threads Number of host threads to use.
+     * @return The number of pages mapped from the file.
+     */
+    static uint64_t read(const std::string &path, uint8_t *pmem,
+                         uint64_t size, bool lazy, unsigned threads);
+
+  private:
+    /**
+     * Maximum number of mappings a lazy restore creates, well below the
+     * default limit on the number of mappings of a Linux process.
+     */
+    static constexpr uint64_t maxMappings = 16384;
+
+    /**
+     * Minimum number of pages of the runs mapped lazily, when there are
+     * too many runs to map them all.
+     */
+    static constexpr uint64_t minMappedRun = 16;
+};
+
+/**
+ * An image of a memory as its gzip compressed contents, the format of
+ * the checkpoints predating the page images, and of the memories whose
+ * size is not a multiple of the page size.
+ */
+class GzipImage
+{
+  public:
+    /**
+     * Write the image of a memory.
+     *
+     * @param path Path of the image file.
+     * @param pmem The memory.
+     * @param size Size of the memory.
+     * @param populated One bit per chunk of the memory, clear when the
+     *                  host never populated the chunk. These chunks are
+     *                  written as zeros without being read. All the
+     *                  chunks are read if empty.
+     * @param chunk_size Size of the chunks.
+     */
+    static void write(const std::string &path, const uint8_t *pmem,
+                      uint64_t size,
+                      const std::vector<bool> &populated = {},
+                      uint64_t chunk_size = 0);
+
+    /**
+     * Restore the image of a memory into zero-filled memory. Only the
+     * non-zero words are written, so that the host doesn't populate the
+     * pages full of zeros.
+     *
+     * @param path Path of the image file.
+     * @param pmem The memory, which must be zero-filled.
+     * @param size Size of the memory.
+     */
+    static void read(const std::string &path, uint8_t *pmem,
+                     uint64_t size);
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_PAGE_IMAGE_HH__
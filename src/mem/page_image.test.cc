@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mem/page_image.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+/** Private anonymous memory, as backing stores are. */
+struct Memory
+{
+    uint64_t size;
+    uint8_t *pmem;
+
+    Memory(uint64_t _size) : size(_size)
+    {
+        pmem = (uint8_t *)mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    ~Memory() { munmap(pmem, size); }
+};
+
+class PageImageTest : public ::testing::Test
+{
+  protected:
+    const uint64_t pageSize = sysconf(_SC_PAGESIZE);
+    const uint64_t numPages = 64;
+    const std::string path = ::testing::TempDir() + "page_image.test.pmem";
+
+    Memory orig{numPages * pageSize};
+
+    void
+    SetUp() override
+    {
+        ASSERT_NE(orig.pmem, MAP_FAILED);
+        // Pages 0-7 hold zeros, 8-23 a run of unique pages, 24-31 copies
+        // of page 8 and the others copies of the run
+        for (uint64_t p = 8; p < 24; p++)
+            std::memset(orig.pmem + p * pageSize, p, pageSize);
+        for (uint64_t p = 24; p < 32; p++)
+            std::memcpy(orig.pmem + p * pageSize, orig.pmem + 8 * pageSize,
+                        pageSize);
+        for (uint64_t p = 32; p < numPages; p++) {
+            std::memcpy(orig.pmem + p * pageSize,
+                        orig.pmem + (8 + p % 16) * pageSize, pageSize);
+        }
+        // A page with a different byte, whose hash may still collide
+        orig.pmem[20 * pageSize + 7] = 0xff;
+    }
+
+    void TearDown() override { std::remove(path.c_str()); }
+
+    uint64_t
+    roundTrip(bool compress, bool lazy)
+    {
+        PageImage::write(path, orig.pmem, orig.size, pageSize, compress, 4);
+        Memory restored(orig.size);
+        const uint64_t mapped =
+            PageImage::read(path, restored.pmem, restored.size, lazy, 4);
+        EXPECT_EQ(std::memcmp(orig.pmem, restored.pmem, orig.size), 0);
+        return mapped;
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(PageImageTest, Uncompressed)
+{
+    EXPECT_EQ(roundTrip(false, false), 0u);
+}
+
+TEST_F(PageImageTest, Compressed)
+{
+    EXPECT_EQ(roundTrip(true, true), 0u);
+}
+
+/** All the non-zero pages are mapped from the file. */
+TEST_F(PageImageTest, Lazy)
+{
+    EXPECT_EQ(roundTrip(false, true), numPages - 8);
+}
+
+/** Zero and duplicate pages are not stored. */
+TEST_F(PageImageTest, Deduplicated)
+{
+    PageImage::write(path, orig.pmem, orig.size, pageSize, false, 4);
+    FILE *f = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(f, nullptr);
+    PageImage::Header header;
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1, f), 1u);
+    std::fclose(f);
+    EXPECT_EQ(header.numPages, numPages);
+    // The modified page 20 differs from the copies of the original one
+    EXPECT_EQ(header.numStored, 17u);
+}
+
+/** Pages written to the image after a lazy restore are private. */
+TEST_F(PageImageTest, LazyPrivate)
+{
+    PageImage::write(path, orig.pmem, orig.size, pageSize, false, 4);
+    Memory restored(orig.size);
+    PageImage::read(path, restored.pmem, restored.size, true, 4);
+    restored.pmem[8 * pageSize] = 0;
+
+    Memory again(orig.size);
+    PageImage::read(path, again.pmem, again.size, true, 4);
+    EXPECT_EQ(again.pmem[8 * pageSize], 8);
+    EXPECT_EQ(again.pmem[24 * pageSize], 8);
+}
+
+/** The pages of unpopulated chunks are imaged as zeros, unread. */
+TEST_F(PageImageTest, Unpopulated)
+{
+    // Chunks of 8 pages, the second and the last ones unpopulated
+    std::vector<bool> populated(numPages / 8, true);
+    populated[1] = false;
+    populated.back() = false;
+    PageImage::write(path, orig.pmem, orig.size, pageSize, false, 4,
+                     populated, 8 * pageSize);
+
+    Memory restored(orig.size);
+    PageImage::read(path, restored.pmem, restored.size, false, 4);
+    for (uint64_t p = 0; p < numPages; p++) {
+        const uint8_t *page = restored.pmem + p * pageSize;
+        if (populated[p / 8]) {
+            EXPECT_EQ(std::memcmp(page, orig.pmem + p * pageSize,
+                                  pageSize), 0);
+        } else {
+            EXPECT_EQ(page[0], 0);
+            EXPECT_EQ(std::memcmp(page, page + 1, pageSize - 1), 0);
+        }
+    }
+}
+
+/** Round trip through the gzip images. */
+TEST_F(PageImageTest, Gzip)
+{
+    GzipImage::write(path, orig.pmem, orig.size);
+    Memory restored(orig.size);
+    GzipImage::read(path, restored.pmem, restored.size);
+    EXPECT_EQ(std::memcmp(orig.pmem, restored.pmem, orig.size), 0);
+}
+
+/** The unpopulated chunks of gzip images are written as zeros. */
+TEST_F(PageImageTest, GzipUnpopulated)
+{
+    std::vector<bool> populated(numPages / 8, true);
+    populated[2] = false;
+    GzipImage::write(path, orig.pmem, orig.size, populated, 8 * pageSize);
+
+    Memory expected(orig.size);
+    std::memcpy(expected.pmem, orig.pmem, orig.size);
+    std::memset(expected.pmem + 16 * pageSize, 0, 8 * pageSize);
+
+    Memory restored(orig.size);
+    GzipImage::read(path, restored.pmem, restored.size);
+    EXPECT_EQ(std::memcmp(expected.pmem, restored.pmem, orig.size), 0);
+}
+
+/** Checkpoints predating the page images compress the whole memory. */
+TEST_F(PageImageTest, GzipCheckpoint)
+{
+    gzFile file = gzopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(gzwrite(file, orig.pmem, orig.size), (int)orig.size);
+    ASSERT_EQ(gzclose(file), Z_OK);
+
+    Memory restored(orig.size);
+    GzipImage::read(path, restored.pmem, restored.size);
+    EXPECT_EQ(std::memcmp(orig.pmem, restored.pmem, orig.size), 0);
+}
@@ -33,6 +33,10 @@
  */
 #include "mem/page_table.hh"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <sstream>
 #include <string>
 
 #include "base/compiler.hh"
@@ -44,6 +48,76 @@
 namespace gem5
 {
 
+namespace
+{
+
+/** A leaf recently used by the host thread. */
+struct CachedLeaf
+{
+    uint64_t table = 0;
+    Addr tag = 0;
+    void *leaf = nullptr;
+};
+
+/** Number of leaves cached by each host thread, a power of 2. */
+constexpr unsigned leafCacheSize = 4;
+
+thread_local std::array<CachedLeaf, leafCacheSize> leafCache;
+
+} // anonymous namespace
+
+uint64_t
+EmulationPageTable::nextId()
+{
+    // Identifiers are never reused, so that the entries cached for a
+    // deleted page table can't match
+    static std::atomic<uint64_t> next_id(1);
+    return next_id++;
+}
+
+EmulationPageTable::Leaf *
+EmulationPageTable::findLeaf(Addr vaddr, bool allocate)
+{
+    const Addr tag = vaddr >> (pageBits + leafBits);
+    CachedLeaf &cached = leafCache[tag & (leafCacheSize - 1)];
+    if (cached.table == id && cached.tag == tag)
+        return static_cast<Leaf *>(cached.leaf);
+
+    Leaf *leaf;
+    auto it = leaves.find(tag);
+    if (it != leaves.end()) {
+        leaf = it->second.get();
+    } else if (allocate) {
+        leaf = leaves.emplace(tag, std::make_unique<Leaf>())
+            .first->second.get();
+    } else {
+        return nullptr;
+    }
+
+    cached.table = id;
+    cached.tag = tag;
+    cached.leaf = leaf;
+    return leaf;
+}
+
+std::vector<std::pair<Addr, EmulationPageTable::Entry>>
+EmulationPageTable::sortedMappings() const
+{
+    std::vector<std::pair<Addr, Entry>> mappings;
+    mappings.reserve(numPages);
+    for (auto &[tag, leaf]: leaves) {
+        for (unsigned i = 0; i < leafPages; i++) {
+            if (leaf->valid[i]) {
+                Addr vaddr = ((tag << leafBits) + i) << pageBits;
+                mappings.emplace_back(vaddr, leaf->entries[i]);
+            }
+        }
+    }
+    std::sort(mappings.begin(), mappings.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+    return mappings;
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -54,16 +128,18 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
+        Leaf *leaf = findLeaf(vaddr, true);
+        unsigned idx = leafIndex(vaddr);
+        if (leaf->valid[idx]) {
             // already mapped
             panic_if(!clobber,
                      "EmulationPageTable::allocate: addr %#x already mapped",
                      vaddr);
-            it->second = Entry(paddr, flags);
         } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
+            leaf->valid[idx] = true;
+            numPages++;
         }
+        leaf->entries[idx] = Entry(paddr, flags);
 
         size -= _pageSize;
         vaddr += _pageSize;
@@ -81,12 +157,16 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
             new_vaddr, size);
 
     while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
-
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
+        Leaf *old_leaf = findLeaf(vaddr);
+        unsigned old_idx = leafIndex(vaddr);
+        assert(old_leaf && old_leaf->valid[old_idx]);
+        Leaf *new_leaf = findLeaf(new_vaddr, true);
+        unsigned new_idx = leafIndex(new_vaddr);
+        assert(!new_leaf->valid[new_idx]);
+
+        new_leaf->entries[new_idx] = old_leaf->entries[old_idx];
+        new_leaf->valid[new_idx] = true;
+        old_leaf->valid[old_idx] = false;
         size -= _pageSize;
         vaddr += _pageSize;
         new_vaddr += _pageSize;
@@ -96,8 +176,8 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    for (auto &[vaddr, entry]: sortedMappings())
+        addr_maps->push_back(std::make_pair(vaddr, entry.paddr));
 }
 
 void
@@ -108,9 +188,11 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
+        Leaf *leaf = findLeaf(vaddr);
+        unsigned idx = leafIndex(vaddr);
+        assert(leaf && leaf->valid[idx]);
+        leaf->valid[idx] = false;
+        numPages--;
         size -= _pageSize;
         vaddr += _pageSize;
     }
@@ -123,7 +205,7 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     assert(pageOffset(vaddr) == 0);
 
     for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
+        if (lookup(vaddr + offset))
             return false;
 
     return true;
@@ -132,11 +214,13 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
+    Leaf *leaf = findLeaf(vaddr);
+    if (!leaf)
         return nullptr;
-    return &(iter->second);
+    unsigned idx = leafIndex(vaddr);
+    if (!leaf->valid[idx])
+        return nullptr;
+    return &leaf->entries[idx];
 }
 
 bool
@@ -172,31 +256,51 @@ void
 EmulationPageTable::PageTableTranslationGen::translate(Range &range) const
 {
     const Addr page_size = pt->pageSize();
+    const Addr remaining = range.size;
 
     Addr next = roundUp(range.vaddr, page_size);
     if (next == range.vaddr)
         next += page_size;
-    range.size = std::min(range.size, next - range.vaddr);
+    range.size = std::min(remaining, next - range.vaddr);
 
-    if (!pt->translate(range.vaddr, range.paddr))
+    const Entry *entry = pt->lookup(range.vaddr);
+    if (!entry) {
         range.fault = Fault(new GenericPageTableFault(range.vaddr));
+        return;
+    }
+    range.paddr = entry->paddr + pt->pageOffset(range.vaddr);
+    range.flags = flags;
+    if (entry->flags & Uncacheable)
+        range.flags.set(Request::UNCACHEABLE | Request::STRICT_ORDER);
+
+    // Extend the range over the following pages as long as they are
+    // physically contiguous and mapped with the same flags
+    const uint64_t map_flags = entry->flags;
+    while (range.size < remaining) {
+        const Entry *next_entry = pt->lookup(range.vaddr + range.size);
+        if (!next_entry || next_entry->flags != map_flags ||
+                next_entry->paddr != range.paddr + range.size) {
+            break;
+        }
+        range.size += std::min(remaining - range.size, page_size);
+    }
 }
 
 void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
     ScopedCheckpointSection sec(cp, "ptable");
-    paramOut(cp, "size", pTable.size());
+    paramOut(cp, "size", numPages);
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    size_t count = 0;
+    for (auto &[vaddr, entry]: sortedMappings()) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
     }
-    assert(count == pTable.size());
+    assert(count == numPages);
 }
 
 void
@@ -216,7 +320,13 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        Leaf *leaf = findLeaf(vaddr, true);
+        unsigned idx = leafIndex(vaddr);
+        if (!leaf->valid[idx]) {
+            leaf->entries[idx] = Entry(paddr, flags);
+            leaf->valid[idx] = true;
+            numPages++;
+        }
     }
 }
 
@@ -224,9 +334,8 @@ const std::string
 EmulationPageTable::externalize() const
 {
     std::stringstream ss;
-    for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
-        ss << std::hex << it->first << ":" << it->second.paddr << ";";
-    }
+    for (auto &[vaddr, entry]: sortedMappings())
+        ss << std::hex << vaddr << ":" << entry.paddr << ";";
     return ss.str();
 }
 
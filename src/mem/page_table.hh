@@ -35,8 +35,14 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
@@ -63,12 +69,53 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
-    PTable pTable;
+    /** log2 of the number of pages mapped by a leaf. */
+    static constexpr unsigned leafBits = 9;
+    static constexpr unsigned leafPages = 1 << leafBits;
+
+    /**
+     * The mappings of an aligned group of leafPages pages, indexed by
+     * page number. Leaves are only freed with the page table, so that
+     * pointers to them can be cached.
+     */
+    struct Leaf
+    {
+        std::array<Entry, leafPages> entries;
+        std::bitset<leafPages> valid;
+    };
+
+    /** Leaves by page number divided by leafPages. */
+    std::unordered_map<Addr, std::unique_ptr<Leaf>> leaves;
+
+    /** Number of mapped pages. */
+    size_t numPages = 0;
 
     const Addr _pageSize;
     const Addr offsetMask;
+    const unsigned pageBits;
+
+    /** Unique identifier of the table, for the translation caches. */
+    const uint64_t id;
+
+    /**
+     * Find the leaf mapping a page, through a small per host thread
+     * cache of the last leaves used.
+     *
+     * @param vaddr Virtual address in the page.
+     * @param allocate Whether to create the leaf if it does not exist.
+     * @return The leaf, or nullptr if it does not exist.
+     */
+    Leaf *findLeaf(Addr vaddr, bool allocate=false);
+
+    /** The entry of a page in its leaf. */
+    unsigned
+    leafIndex(Addr vaddr) const
+    {
+        return (vaddr >> pageBits) & (leafPages - 1);
+    }
+
+    /** All the mappings, sorted by virtual address. */
+    std::vector<std::pair<Addr, Entry>> sortedMappings() const;
 
     const uint64_t _pid;
     const std::string _name;
@@ -78,13 +125,19 @@ class EmulationPageTable : public Serializable
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
             _pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
-            _pid(_pid), _name(__name), shared(false)
+            pageBits(floorLog2(_pageSize)), id(nextId()), _pid(_pid),
+            _name(__name), shared(false)
     {
         assert(isPowerOf2(_pageSize));
     }
 
     uint64_t pid() const { return _pid; };
 
+  private:
+    static uint64_t nextId();
+
+  public:
+
     virtual ~EmulationPageTable() {};
 
     /* generic page table mapping flags
@@ -161,24 +214,33 @@ class EmulationPageTable : public Serializable
         return translate(vaddr, dummy);
     }
 
+    /**
+     * Translates the virtual pages of a range, in chunks of virtually and
+     * physically contiguous pages with the same flags, so that the
+     * accesses to buffers spanning many pages can be done in a few
+     * blocks.
+     */
     class PageTableTranslationGen : public TranslationGen
     {
       private:
         EmulationPageTable *pt;
+        /** Request flags of the ranges, on top of the mapping ones. */
+        Request::Flags flags;
 
         void translate(Range &range) const override;
 
       public:
         PageTableTranslationGen(EmulationPageTable *_pt, Addr vaddr,
-                Addr size) : TranslationGen(vaddr, size), pt(_pt)
+                Addr size, Request::Flags _flags=0) :
+            TranslationGen(vaddr, size), pt(_pt), flags(_flags)
         {}
     };
 
     TranslationGenPtr
-    translateRange(Addr vaddr, Addr size)
+    translateRange(Addr vaddr, Addr size, Request::Flags flags=0)
     {
         return TranslationGenPtr(
-                new PageTableTranslationGen(this, vaddr, size));
+                new PageTableTranslationGen(this, vaddr, size, flags));
     }
 
     /**
@@ -189,7 +251,8 @@ class EmulationPageTable : public Serializable
     Fault translate(const RequestPtr &req);
 
     /**
-     * Dump all items in the pTable, to a concatenation of strings of the form
+     * Dump all the mappings, sorted by address, to a concatenation of
+     * strings of the form
      *    Addr:Entry;
      */
     const std::string externalize() const;
@@ -42,19 +42,22 @@
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
-#include <zlib.h>
 
+#include <algorithm>
 #include <cerrno>
-#include <climits>
+#include <cstdint>
 #include <cstdio>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/page_image.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -80,8 +83,13 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               bool sparse_backstore,
+                               enums::MemoryCheckpointFormat
+                                   checkpoint_format) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
+    sparseBackstore(sparse_backstore && shared_backstore.empty()),
+    checkpointFormat(checkpoint_format),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
     pageSize(sysconf(_SC_PAGE_SIZE))
 {
@@ -90,9 +98,12 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
     }
 
-    if (mmap_using_noreserve)
+    if (mmap_using_noreserve || sparseBackstore)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    warn_if(sparse_backstore && !sparseBackstore,
+            "A shared backing store can't be sparse\n");
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -234,11 +245,16 @@ PhysicalMemory::createBackingStore(
 
     // to be able to simulate very large memories, the user can opt to
     // pass noreserve to mmap
-    if (mmapUsingNoReserve) {
+    if (mmapUsingNoReserve || sparseBackstore) {
         map_flags |= MAP_NORESERVE;
     }
 
-    uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
+    // huge pages can only back the aligned parts of the mapping, so a
+    // sparse backing store is mapped with some slack to align it
+    const uint64_t map_size = range.size() +
+        (sparseBackstore ? sparseChunkSize : 0);
+
+    uint8_t* pmem = (uint8_t*) mmap(NULL, map_size,
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, map_offset);
 
@@ -248,6 +264,22 @@ PhysicalMemory::createBackingStore(
               range.to_string());
     }
 
+    if (sparseBackstore) {
+        uint8_t *aligned = (uint8_t *)roundUp((uintptr_t)pmem,
+                                              sparseChunkSize);
+        uint8_t *map_end = pmem + map_size;
+        if (aligned != pmem)
+            munmap(pmem, aligned - pmem);
+        if (map_end != aligned + range.size())
+            munmap(aligned + range.size(), map_end - aligned - range.size());
+        pmem = aligned;
+
+#ifdef MADV_HUGEPAGE
+        if (madvise(pmem, range.size(), MADV_HUGEPAGE))
+            warn("Transparent huge pages are not available on this host\n");
+#endif
+    }
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
@@ -359,14 +391,70 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     }
 }
 
+std::vector<bool>
+PhysicalMemory::populatedChunks(const uint8_t *pmem, uint64_t size) const
+{
+    const uint64_t num_chunks = divCeil(size, sparseChunkSize);
+    std::vector<bool> populated(num_chunks, true);
+
+#if defined(__linux__)
+    // Each entry of the page map of the process describes a host page,
+    // bit 63 telling if it is in memory and bit 62 if it is swapped
+    const int fd = open("/proc/self/pagemap", O_RDONLY);
+    if (fd < 0)
+        return populated;
+
+    const uint64_t pages_per_chunk = sparseChunkSize / pageSize;
+    std::vector<uint64_t> entries(pages_per_chunk);
+    const uint64_t first_page = (uintptr_t)pmem / pageSize;
+    const uint64_t populated_bits = (1ULL << 63) | (1ULL << 62);
+
+    for (uint64_t chunk = 0; chunk < num_chunks; chunk++) {
+        const uint64_t pages = std::min(pages_per_chunk,
+                divCeil(size - chunk * sparseChunkSize, (uint64_t)pageSize));
+        const off_t offset =
+            (first_page + chunk * pages_per_chunk) * sizeof(uint64_t);
+        const ssize_t bytes = pages * sizeof(uint64_t);
+        if (pread(fd, entries.data(), bytes, offset) != bytes)
+            break;
+
+        populated[chunk] = false;
+        for (uint64_t i = 0; i < pages; i++) {
+            if (entries[i] & populated_bits) {
+                populated[chunk] = true;
+                break;
+            }
+        }
+    }
+
+    close(fd);
+#endif
+
+    return populated;
+}
+
+unsigned
+PhysicalMemory::imageThreads()
+{
+    return std::clamp(std::thread::hardware_concurrency(), 1u,
+                      maxImageThreads);
+}
+
 void
 PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
                                AddrRange range, uint8_t* pmem) const
 {
+    // page images are made of whole pages
+    const bool page_image = checkpointFormat != enums::gzip &&
+        range.size() % pageSize == 0;
+    warn_if(checkpointFormat != enums::gzip && !page_image,
+            "Checkpointing %s with gzip, its size is not a multiple of "
+            "the page size\n", range.to_string());
+
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
-    std::string filename =
-        name() + ".store" + std::to_string(store_id) + ".pmem";
+    std::string filename = name() + ".store" + std::to_string(store_id) +
+        (page_image ? ".pages" : ".pmem");
     long range_size = range.size();
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
@@ -378,32 +466,27 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
-    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'\n",
-              filename);
-
-    uint64_t pass_size = 0;
-
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
-
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
-        }
-    }
 
-    // close the compressed stream and check that the exit status
-    // is zero
-    if (gzclose(compressed_mem))
-        fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+    // Write the chunks the host never populated as zeros, so that
+    // reading them doesn't populate them
+    std::vector<bool> populated;
+    if (sparseBackstore) {
+        populated = populatedChunks(pmem, range.size());
+        DPRINTF(Checkpoint, "%d of %d chunks of %s are populated\n",
+                std::count(populated.begin(), populated.end(), true),
+                populated.size(), filename);
+    }
 
+    if (page_image) {
+        std::string image_format = "pages";
+        SERIALIZE_SCALAR(image_format);
+        PageImage::write(filepath, pmem, range.size(), pageSize,
+                         checkpointFormat == enums::compressed_pages,
+                         imageThreads(), populated, sparseChunkSize);
+    } else {
+        GzipImage::write(filepath, pmem, range.size(), populated,
+                         sparseChunkSize);
+    }
 }
 
 void
@@ -434,8 +517,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -443,11 +524,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -462,33 +538,29 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
-    uint64_t curr_size = 0;
-    long* temp_page = new long[chunk_size];
-    long* pmem_current;
-    uint32_t bytes_read;
-    while (curr_size < range.size()) {
-        bytes_read = gzread(compressed_mem, temp_page, chunk_size);
-        if (bytes_read == 0)
-            break;
-
-        assert(bytes_read % sizeof(long) == 0);
-
-        for (uint32_t x = 0; x < bytes_read / sizeof(long); x++) {
-            // Only copy bytes that are non-zero, so we don't give
-            // the VM system hell
-            if (*(temp_page + x) != 0) {
-                pmem_current = (long*)(pmem + curr_size + x * sizeof(long));
-                *pmem_current = *(temp_page + x);
-            }
-        }
-        curr_size += bytes_read;
+    // checkpoints predating the page images don't name their format
+    std::string image_format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(image_format);
+
+    if (image_format == "pages") {
+        // Pages can only be mapped over private backing stores. The
+        // population bitmaps of sparse ones would miss the pages mapped
+        // but not yet read.
+        const bool lazy =
+            backingStore[store_id].shmFd == -1 && !sparseBackstore;
+        const uint64_t mapped = PageImage::read(filepath, pmem,
+                                                range.size(), lazy,
+                                                imageThreads());
+        DPRINTF(Checkpoint, "Mapped %d pages of %s from the checkpoint\n",
+                mapped, filename);
+        return;
     }
 
-    delete[] temp_page;
+    fatal_if(image_format != "gzip",
+             "Unknown format '%s' of physical memory checkpoint file '%s'\n",
+             image_format, filename);
 
-    if (gzclose(compressed_mem))
-        fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+    GzipImage::read(filepath, pmem, range.size());
 }
 
 } // namespace memory
@@ -44,6 +44,7 @@
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/MemoryCheckpointFormat.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -153,6 +154,12 @@ class PhysicalMemory : public Serializable
     // Let the user choose if we reserve swap space when calling mmap
     const bool mmapUsingNoReserve;
 
+    // Populate the private backing stores lazily, with huge pages
+    const bool sparseBackstore;
+
+    // Format of the backing stores in checkpoints
+    const enums::MemoryCheckpointFormat checkpointFormat;
+
     const std::string sharedBackstore;
     uint64_t sharedBackstoreSize;
 
@@ -162,6 +169,33 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    /**
+     * Granularity of the population bitmaps of the sparse backing
+     * stores, and alignment of their host mappings, the size of the
+     * transparent huge pages of common hosts.
+     */
+    static constexpr Addr sparseChunkSize = 2 * 1024 * 1024;
+
+    /**
+     * Find which chunks of sparseChunkSize bytes of a backing store the
+     * host populated, i.e. keeps in memory or in swap. The host keeps
+     * track of this anyway, so it is asked rather than every write to
+     * the store being tracked.
+     *
+     * @param pmem The host memory of the backing store.
+     * @param size The size of the backing store.
+     * @return One bit per chunk, set when the chunk is populated. All
+     *         the bits are set if the host can't tell.
+     */
+    std::vector<bool> populatedChunks(const uint8_t *pmem,
+                                      uint64_t size) const;
+
+    /** Maximum number of host threads writing or reading page images. */
+    static constexpr unsigned maxImageThreads = 16;
+
+    /** Number of host threads to write or read page images with. */
+    static unsigned imageThreads();
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +225,10 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   bool sparse_backstore=false,
+                   enums::MemoryCheckpointFormat checkpoint_format=
+                       enums::gzip);
 
     /**
      * Unmap all the backing store we have used.
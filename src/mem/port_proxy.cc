@@ -37,6 +37,8 @@
 
 #include "mem/port_proxy.hh"
 
+#include <algorithm>
+
 #include "base/chunk_generator.hh"
 #include "cpu/thread_context.hh"
 #include "mem/port.hh"
@@ -46,7 +48,10 @@ namespace gem5
 
 PortProxy::PortProxy(ThreadContext *tc, Addr cache_line_size) :
     PortProxy([tc](PacketPtr pkt)->void { tc->sendFunctional(pkt); },
-        cache_line_size)
+        cache_line_size,
+        [tc](const MemBackdoorReq &req, MemBackdoorPtr &backdoor)->void {
+            tc->sendMemBackdoorReq(req, backdoor);
+        })
 {}
 
 PortProxy::PortProxy(const RequestPort &port, Addr cache_line_size) :
@@ -71,6 +76,28 @@ PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
     }
 }
 
+uint8_t *
+PortProxy::hostPtrPhys(Addr addr, uint64_t &size, bool write) const
+{
+    if (!sendMemBackdoorReq || size == 0)
+        return nullptr;
+
+    MemBackdoorPtr backdoor = nullptr;
+    sendMemBackdoorReq(MemBackdoorReq(RangeSize(addr, size),
+                write ? MemBackdoor::Flags(MemBackdoor::Readable |
+                                           MemBackdoor::Writeable) :
+                        MemBackdoor::Readable),
+            backdoor);
+    if (!backdoor || !backdoor->ptr() || !backdoor->range().contains(addr))
+        return nullptr;
+    if (!backdoor->readable() || (write && !backdoor->writeable()))
+        return nullptr;
+
+    const AddrRange &range = backdoor->range();
+    size = std::min(size, range.end() - addr);
+    return backdoor->ptr() + (addr - range.start());
+}
+
 void
 PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
                          const void *p, uint64_t size) const
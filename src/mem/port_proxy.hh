@@ -87,9 +87,14 @@ class PortProxy : FunctionalRequestProtocol
 {
   public:
     typedef std::function<void(PacketPtr pkt)> SendFunctionalFunc;
+    typedef std::function<void(const MemBackdoorReq &req,
+                               MemBackdoorPtr &backdoor)>
+        SendMemBackdoorReqFunc;
 
   private:
     SendFunctionalFunc sendFunctional;
+    /** Optional, to access the memory in place through back doors. */
+    SendMemBackdoorReqFunc sendMemBackdoorReq;
 
     /** Granularity of any transactions issued through this proxy. */
     const Addr _cacheLineSize;
@@ -103,8 +108,10 @@ class PortProxy : FunctionalRequestProtocol
     }
 
   public:
-    PortProxy(SendFunctionalFunc func, Addr cache_line_size) :
-        sendFunctional(func), _cacheLineSize(cache_line_size)
+    PortProxy(SendFunctionalFunc func, Addr cache_line_size,
+              SendMemBackdoorReqFunc backdoor_func=nullptr) :
+        sendFunctional(func), sendMemBackdoorReq(backdoor_func),
+        _cacheLineSize(cache_line_size)
     {}
 
     // Helpers which create typical SendFunctionalFunc-s from other objects.
@@ -134,6 +141,20 @@ class PortProxy : FunctionalRequestProtocol
     void memsetBlobPhys(Addr addr, Request::Flags flags,
                         uint8_t v, uint64_t size) const;
 
+    /**
+     * Find the host memory backing a physical address, through a memory
+     * back door.
+     *
+     * @param addr The physical address.
+     * @param size The number of bytes to access, reduced to the number
+     *             of bytes the back door covers.
+     * @param write Whether the memory is going to be written.
+     * @return A pointer to the host memory, or nullptr if there is no
+     *         back door to it, e.g. because a cache could hold a more
+     *         recent copy of the data.
+     */
+    uint8_t *hostPtrPhys(Addr addr, uint64_t &size, bool write) const;
+
 
 
     /** Methods to override in base classes */
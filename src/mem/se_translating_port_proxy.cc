@@ -40,6 +40,7 @@
 
 #include "mem/se_translating_port_proxy.hh"
 
+#include "mem/page_table.hh"
 #include "sim/process.hh"
 #include "sim/system.hh"
 
@@ -51,6 +52,28 @@ SETranslatingPortProxy::SETranslatingPortProxy(
     TranslatingPortProxy(tc, _flags), allocating(alloc)
 {}
 
+TranslationGenPtr
+SETranslatingPortProxy::translateRange(
+        Addr addr, uint64_t size, BaseMMU::Mode mode) const
+{
+    // Ranges which are not all mapped, or which the MMU would transform
+    // or check, are translated by the MMU, which also grows the stack.
+    if (_tc->getMMUPtr()->seTranslatesDirectly(addr, flags)) {
+        auto gen = _tc->getProcessPtr()->pTable->translateRange(
+                addr, size, flags);
+        bool mapped = true;
+        for (const auto &range: *gen) {
+            if (range.fault) {
+                mapped = false;
+                break;
+            }
+        }
+        if (mapped)
+            return gen;
+    }
+    return TranslatingPortProxy::translateRange(addr, size, mode);
+}
+
 bool
 SETranslatingPortProxy::fixupRange(const TranslationGen::Range &range,
         BaseMMU::Mode mode) const
@@ -66,6 +89,9 @@ SETranslatingPortProxy::fixupRange(const TranslationGen::Range &range,
             // We've accessed the next page on the stack.
             return true;
         }
+    } else if (mode == BaseMMU::Read && process->fixupFault(range.vaddr)) {
+        // Reads grow the stack too, as the SE mode TLBs do.
+        return true;
     }
     return false;
 }
@@ -61,6 +61,15 @@ class SETranslatingPortProxy : public TranslatingPortProxy
     AllocType allocating;
 
   protected:
+    /**
+     * Translates through the page table of the process, in chunks of
+     * physically contiguous pages rather than one page at a time, when
+     * the whole range is mapped and the MMU allows it. Other ranges are
+     * translated by the MMU.
+     */
+    TranslationGenPtr translateRange(
+            Addr addr, uint64_t size, BaseMMU::Mode mode) const override;
+
     bool fixupRange(const TranslationGen::Range &range,
             BaseMMU::Mode mode) const override;
 
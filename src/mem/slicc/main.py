@@ -91,6 +91,11 @@ def main(args=None):
         action="store_true",
         help="print traceback on error",
     )
+    parser.add_option(
+        "--dense-transitions",
+        action="store_true",
+        help="dispatch transitions through a dense state x event table",
+    )
     parser.add_option("-q", "--quiet", help="don't print messages")
     opts, files = parser.parse_args(args=args)
 
@@ -118,6 +123,7 @@ def main(args=None):
         verbose=True,
         debug=opts.debug,
         traceback=opts.tb,
+        dense_transitions=opts.dense_transitions,
     )
 
     if opts.print_files:
@@ -54,11 +54,18 @@ from slicc.symbols import SymbolTable
 
 class SLICC(Grammar):
     def __init__(
-        self, filename, base_dir, verbose=False, traceback=False, **kwargs
+        self,
+        filename,
+        base_dir,
+        verbose=False,
+        traceback=False,
+        dense_transitions=False,
+        **kwargs,
     ):
         self.protocol = None
         self.traceback = traceback
         self.verbose = verbose
+        self.dense_transitions = dense_transitions
         self.symtab = SymbolTable(self)
         self.base_dir = base_dir
 
@@ -1556,7 +1556,9 @@ ${ident}_Controller::wakeup()
             """
 // ${ident}: ${{self.short}}
 
+#include <array>
 #include <cassert>
+#include <cstdint>
 
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -1725,7 +1727,6 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
 {
     m_curTransitionEvent = event;
     m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
 """
         )
 
@@ -1832,14 +1833,44 @@ if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
 
             cases[case].append(case_string)
 
-        # Walk through all of the unique code blocks and spit out the
-        # corresponding case statement elements
-        for case, transitions in cases.items():
-            # Iterative over all the multiple transitions that share
-            # the same code
-            for trans in transitions:
-                code("  case HASH_FUN($trans):")
-            code("    $case\n")
+        if self.symtab.slicc.dense_transitions:
+            # Number the unique code blocks 1..N and map every valid
+            # (state, event) pair onto its block through a flat table built
+            # at compile time. The switch then covers a small contiguous
+            # range, which the compiler always lowers to a jump table, rather
+            # than the sparse HASH_FUN space. Index 0 marks an invalid
+            # transition.
+            code(
+                """
+    static constexpr auto transitionCase = [] {
+        std::array<uint16_t, ${ident}_State_NUM * ${ident}_Event_NUM> t{};
+"""
+            )
+            for idx, transitions in enumerate(cases.values(), 1):
+                for trans in transitions:
+                    code("        t[HASH_FUN($trans)] = $idx;")
+            code(
+                """
+        return t;
+    }();
+
+    switch(transitionCase[HASH_FUN(state, event)]) {
+"""
+            )
+            for idx, case in enumerate(cases.keys(), 1):
+                code("  case $idx:")
+                code("    $case\n")
+        else:
+            code("    switch(HASH_FUN(state, event)) {")
+
+            # Walk through all of the unique code blocks and spit out the
+            # corresponding case statement elements
+            for case, transitions in cases.items():
+                # Iterative over all the multiple transitions that share
+                # the same code
+                for trans in transitions:
+                    code("  case HASH_FUN($trans):")
+                code("    $case\n")
 
         code(
             """
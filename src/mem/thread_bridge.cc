@@ -27,6 +27,11 @@
 
 #include "mem/thread_bridge.hh"
 
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "sim/eventq.hh"
 
@@ -34,8 +39,103 @@ namespace gem5
 {
 
 ThreadBridge::ThreadBridge(const ThreadBridgeParams &p)
-    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this)
+    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this),
+      delay_(p.delay)
+{
+}
+
+void
+ThreadBridge::deliver(PacketPtr pkt, EventQueue *queue,
+                      std::list<PacketPtr> &in_flight,
+                      std::deque<PacketPtr> &packets,
+                      void (ThreadBridge::*send)())
+{
+    const Tick when = curTick() + delay_ + pkt->headerDelay +
+        pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+    {
+        std::lock_guard<UncontendedMutex> lock(in_flight_lock_);
+        in_flight.push_back(pkt);
+    }
+
+    // The event is scheduled from this thread, but runs on the thread
+    // of the other queue, which alone touches the packets to send
+    auto *event = new EventFunctionWrapper([this, pkt, &packets, send]() {
+        packets.push_back(pkt);
+        (this->*send)();
+    }, name() + ".deliver", true);
+    queue->schedule(event, when);
+}
+
+void
+ThreadBridge::sendRequests()
+{
+    while (!waiting_req_retry_ && !requests_.empty()) {
+        PacketPtr pkt = requests_.front();
+        if (!out_port_.sendTimingReq(pkt)) {
+            waiting_req_retry_ = true;
+            return;
+        }
+        requests_.pop_front();
+        packetSent(in_flight_requests_, pkt);
+    }
+}
+
+void
+ThreadBridge::sendResponses()
 {
+    while (!waiting_resp_retry_ && !responses_.empty()) {
+        PacketPtr pkt = responses_.front();
+        if (!in_port_.sendTimingResp(pkt)) {
+            waiting_resp_retry_ = true;
+            return;
+        }
+        responses_.pop_front();
+        packetSent(in_flight_responses_, pkt);
+    }
+}
+
+void
+ThreadBridge::packetSent(std::list<PacketPtr> &in_flight, PacketPtr pkt)
+{
+    bool drained;
+    {
+        std::lock_guard<UncontendedMutex> lock(in_flight_lock_);
+        // Packets are mostly sent in the order they were accepted, so
+        // the search rarely goes past the front
+        auto it = std::find(in_flight.begin(), in_flight.end(), pkt);
+        assert(it != in_flight.end());
+        in_flight.erase(it);
+        drained = in_flight_requests_.empty() &&
+            in_flight_responses_.empty();
+    }
+    if (drained && drainState() == DrainState::Draining)
+        signalDrainDone();
+}
+
+bool
+ThreadBridge::trySatisfyFunctional(PacketPtr pkt) const
+{
+    std::lock_guard<UncontendedMutex> lock(in_flight_lock_);
+    // Like the Bridge, check the responses first, as they are younger
+    // than the requests they answer
+    for (auto *in_flight : {&in_flight_responses_, &in_flight_requests_}) {
+        for (PacketPtr other : *in_flight) {
+            if (pkt->trySatisfyFunctional(other)) {
+                pkt->makeResponse();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+DrainState
+ThreadBridge::drain()
+{
+    std::lock_guard<UncontendedMutex> lock(in_flight_lock_);
+    return in_flight_requests_.empty() && in_flight_responses_.empty() ?
+        DrainState::Drained : DrainState::Draining;
 }
 
 ThreadBridge::IncomingPort::IncomingPort(const std::string &name,
@@ -54,12 +154,23 @@ ThreadBridge::IncomingPort::getAddrRanges() const
 bool
 ThreadBridge::IncomingPort::recvTimingReq(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    if (!device_.requestor_queue_) {
+        device_.requestor_queue_ = curEventQueue();
+        fatal_if(device_.requestor_queue_ != device_.eventQueue() &&
+                 device_.delay_ < simQuantum,
+                 "%s: The delay (%d) must be at least the simulation "
+                 "quantum (%d) across event queues.\n", device_.name(),
+                 device_.delay_, simQuantum);
+    }
+    device_.deliver(pkt, device_.eventQueue(), device_.in_flight_requests_,
+                    device_.requests_, &ThreadBridge::sendRequests);
+    return true;
 }
 void
 ThreadBridge::IncomingPort::recvRespRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.waiting_resp_retry_ = false;
+    device_.sendResponses();
 }
 
 // AtomicResponseProtocol
@@ -74,6 +185,12 @@ ThreadBridge::IncomingPort::recvAtomic(PacketPtr pkt)
 void
 ThreadBridge::IncomingPort::recvFunctional(PacketPtr pkt)
 {
+    pkt->pushLabel(name());
+    const bool satisfied = device_.trySatisfyFunctional(pkt);
+    pkt->popLabel();
+    if (satisfied)
+        return;
+
     EventQueue::ScopedMigration migrate(device_.eventQueue());
     device_.out_port_.sendFunctional(pkt);
 }
@@ -94,12 +211,18 @@ ThreadBridge::OutgoingPort::recvRangeChange()
 bool
 ThreadBridge::OutgoingPort::recvTimingResp(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    panic_if(!device_.requestor_queue_,
+             "%s: Response without a request.\n", device_.name());
+    device_.deliver(pkt, device_.requestor_queue_,
+                    device_.in_flight_responses_, device_.responses_,
+                    &ThreadBridge::sendResponses);
+    return true;
 }
 void
 ThreadBridge::OutgoingPort::recvReqRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.waiting_req_retry_ = false;
+    device_.sendRequests();
 }
 
 Port &
@@ -28,6 +28,10 @@
 #ifndef __MEM_THREAD_BRIDGE_HH__
 #define __MEM_THREAD_BRIDGE_HH__
 
+#include <deque>
+#include <list>
+
+#include "base/uncontended_mutex.hh"
 #include "mem/port.hh"
 #include "params/ThreadBridge.hh"
 #include "sim/sim_object.hh"
@@ -43,6 +47,8 @@ class ThreadBridge : public SimObject
     Port &getPort(const std::string &if_name,
                   PortID idx = InvalidPortID) override;
 
+    DrainState drain() override;
+
   private:
     class IncomingPort : public ResponsePort
     {
@@ -80,6 +86,60 @@ class ThreadBridge : public SimObject
 
     IncomingPort in_port_;
     OutgoingPort out_port_;
+
+    /**
+     * Latency of the timing packets crossing the bridge. When the two
+     * sides are on different event queues, it must be at least the
+     * simulation quantum, so that the packets are never delivered in
+     * the past of the receiving queue.
+     */
+    const Tick delay_;
+
+    /** Event queue of the requestor, known once it sends a request. */
+    EventQueue *requestor_queue_ = nullptr;
+
+    /**
+     * Requests delivered to the event queue of the bridge, waiting to
+     * be sent out, and responses delivered to the event queue of the
+     * requestor. Each is only accessed from the thread of its queue.
+     */
+    std::deque<PacketPtr> requests_;
+    std::deque<PacketPtr> responses_;
+    bool waiting_req_retry_ = false;
+    bool waiting_resp_retry_ = false;
+
+    /**
+     * Requests and responses accepted by one side and not yet sent out
+     * by the other, oldest first, whether or not they were delivered.
+     * Both sides check them for functional accesses, so they are
+     * guarded by the mutex.
+     */
+    std::list<PacketPtr> in_flight_requests_;
+    std::list<PacketPtr> in_flight_responses_;
+    mutable UncontendedMutex in_flight_lock_;
+
+    /**
+     * Deliver a packet to a queue after the bridge latency, and append
+     * it to the packets to send out from there.
+     */
+    void deliver(PacketPtr pkt, EventQueue *queue,
+                 std::list<PacketPtr> &in_flight,
+                 std::deque<PacketPtr> &packets, void (ThreadBridge::*send)());
+
+    void sendRequests();
+    void sendResponses();
+
+    /**
+     * Account for a packet sent out, completing a drain if needed.
+     * @param in_flight The in-flight packets it was part of.
+     */
+    void packetSent(std::list<PacketPtr> &in_flight, PacketPtr pkt);
+
+    /**
+     * Check a functional access against the packets in flight.
+     * @return Whether the access was satisfied, and made a response.
+     */
+    bool trySatisfyFunctional(PacketPtr pkt) const;
 };
 
 }  // namespace gem5
@@ -59,6 +59,13 @@ TranslatingPortProxy::TranslatingPortProxy(
     PortProxy(tc, tc->getSystemPtr()->cacheLineSize()), _tc(tc), flags(_flags)
 {}
 
+TranslationGenPtr
+TranslatingPortProxy::translateRange(
+        Addr addr, uint64_t size, BaseMMU::Mode mode) const
+{
+    return _tc->getMMUPtr()->translateFunctional(addr, size, _tc, mode, flags);
+}
+
 bool
 TranslatingPortProxy::tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
         std::function<void(const TranslationGen::Range &)> func) const
@@ -89,8 +96,7 @@ bool
 TranslatingPortProxy::tryReadBlob(Addr addr, void *p, uint64_t size) const
 {
     constexpr auto mode = BaseMMU::Read;
-    return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
-            addr, size, _tc, mode, flags),
+    return tryOnBlob(mode, translateRange(addr, size, mode),
         [this, &p](const auto &range) {
             PortProxy::readBlobPhys(range.paddr, range.flags, p, range.size);
             p = static_cast<uint8_t *>(p) + range.size;
@@ -102,8 +108,7 @@ TranslatingPortProxy::tryWriteBlob(
         Addr addr, const void *p, uint64_t size) const
 {
     constexpr auto mode = BaseMMU::Write;
-    return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
-            addr, size, _tc, mode, flags),
+    return tryOnBlob(mode, translateRange(addr, size, mode),
         [this, &p](const auto &range) {
             PortProxy::writeBlobPhys(range.paddr, range.flags, p, range.size);
             p = static_cast<const uint8_t *>(p) + range.size;
@@ -114,11 +119,29 @@ bool
 TranslatingPortProxy::tryMemsetBlob(Addr addr, uint8_t v, uint64_t size) const
 {
     constexpr auto mode = BaseMMU::Write;
-    return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
-            addr, size, _tc, mode, flags),
+    return tryOnBlob(mode, translateRange(addr, size, mode),
         [this, v](const auto &range) {
             PortProxy::memsetBlobPhys(range.paddr, range.flags, v, range.size);
     });
 }
 
+bool
+TranslatingPortProxy::tryHostBlob(Addr addr, uint64_t size, bool write,
+        std::function<void(uint8_t *, uint64_t)> func) const
+{
+    const auto mode = write ? BaseMMU::Write : BaseMMU::Read;
+    return tryOnBlob(mode, translateRange(addr, size, mode),
+        [this, write, &func](const auto &range) {
+            Addr paddr = range.paddr;
+            uint64_t left = range.size;
+            while (left) {
+                uint64_t chunk = left;
+                uint8_t *host = hostPtrPhys(paddr, chunk, write);
+                func(host, chunk);
+                paddr += chunk;
+                left -= chunk;
+            }
+    });
+}
+
 } // namespace gem5
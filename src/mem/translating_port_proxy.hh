@@ -69,6 +69,13 @@ class TranslatingPortProxy : public PortProxy
         return false;
     }
 
+    /**
+     * Translates the pages of a range of virtual addresses. By default,
+     * the translations are done one page at a time by the MMU.
+     */
+    virtual TranslationGenPtr translateRange(
+            Addr addr, uint64_t size, BaseMMU::Mode mode) const;
+
     bool tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
             std::function<void(const TranslationGen::Range &)> func) const;
 
@@ -87,6 +94,21 @@ class TranslatingPortProxy : public PortProxy
      * Fill size bytes starting at addr with byte value val.
      */
     bool tryMemsetBlob(Addr address, uint8_t  v, uint64_t size) const override;
+
+    /**
+     * Find the host memory backing a range of virtual addresses, so that
+     * it can be accessed in place.
+     *
+     * @param addr The virtual address of the range.
+     * @param size The size of the range.
+     * @param write Whether the range is going to be written.
+     * @param func Called with each chunk of the range, in order, with a
+     *             pointer to the host memory backing it, or nullptr if
+     *             the chunk has to be accessed through the proxy.
+     * @return False if part of the range could not be translated.
+     */
+    bool tryHostBlob(Addr addr, uint64_t size, bool write,
+            std::function<void(uint8_t *, uint64_t)> func) const;
 };
 
 } // namespace gem5
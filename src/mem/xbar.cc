@@ -64,6 +64,7 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       responseLatency(p.response_latency),
       headerLatency(p.header_latency),
       width(p.width),
+      routes(name()),
       gotAddrRanges(p.port_default_connection_count +
                           p.port_mem_side_ports_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
@@ -337,11 +338,10 @@ BaseXBar::findPort(AddrRange addr_range, PacketPtr pkt)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
-    // Check the address map interval tree
-    auto i = portMap.contains(addr_range);
-    if (i != portMap.end()) {
-        return i->second;
-    }
+    // Check the address map interval tree, through its cache
+    const PortID port_id = portCache.find(addr_range, portMap);
+    if (port_id != InvalidPortID)
+        return port_id;
 
     // Check if this matches the default range
     if (useDefaultRange) {
@@ -441,6 +441,8 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
                       memSidePorts[conflict_id]->getPeer());
             }
         }
+
+        portCache.reset(portMap);
     }
 
     // if we have received ranges from all our neighbouring CPU-side-port
@@ -52,6 +52,7 @@
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
+#include "mem/xbar_routing.hh"
 #include "params/BaseXBar.hh"
 #include "sim/clocked_object.hh"
 #include "sim/stats.hh"
@@ -318,14 +319,25 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /** Cache of the ports found in the port map, in front of it. */
+    XBarPortCache portCache;
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
      * the underlying Request pointer inside the Packet stays
-     * constant.
+     * constant. Only the responses which are not the request packet
+     * returned, e.g. snoop responses, are routed this way, the others
+     * carrying their route, see routes.
      */
     std::unordered_map<RequestPtr, PortID> routeTo;
 
+    /**
+     * Routes of the requests expecting a response, carried by the
+     * requests themselves.
+     */
+    XBarRoutes routes;
+
     /** all contigous ranges seen by this crossbar */
     AddrRangeList xbarRanges;
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the lookup structures of the crossbars.
+ */
+
+#include "mem/xbar_routing.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+void
+XBarPortCache::reset(const PortMap &port_map)
+{
+    // The blocks must not straddle the boundaries of the ranges, nor
+    // the interleaving granules of the interleaved ones
+    Addr block_size = Addr(1) << 63;
+    auto align = [&block_size](Addr addr) {
+        if (addr)
+            block_size = std::min(block_size, addr & -addr);
+    };
+    for (const auto &r : port_map) {
+        align(r.first.start());
+        align(r.first.end());
+        if (r.first.interleaved())
+            block_size = std::min(block_size, r.first.granularity());
+    }
+
+    blockShift = floorLog2(block_size);
+    entries.fill(Entry());
+    hits = 0;
+}
+
+PortID
+XBarPortCache::find(const AddrRange &addr_range, const PortMap &port_map)
+{
+    // Only the ranges within a block are cached
+    Entry *entry = nullptr;
+    const Addr block = addr_range.start() >> blockShift;
+    if (!addr_range.interleaved() && addr_range.size() &&
+            (addr_range.end() - 1) >> blockShift == block) {
+        entry = &entries[block % numEntries];
+        if (entry->block == block) {
+            hits++;
+            return entry->port;
+        }
+    }
+
+    auto i = port_map.contains(addr_range);
+    if (i == port_map.end())
+        return InvalidPortID;
+
+    if (entry) {
+        entry->block = block;
+        entry->port = i->second;
+    }
+    return i->second;
+}
+
+void
+XBarRoutes::push(PacketPtr pkt, PortID port)
+{
+    RouteState *state;
+    if (freeStates.empty()) {
+        states.push_back(std::make_unique<RouteState>(this));
+        state = states.back().get();
+    } else {
+        state = freeStates.back();
+        freeStates.pop_back();
+    }
+
+    state->port = port;
+    pkt->pushSenderState(state);
+}
+
+PortID
+XBarRoutes::routeOf(PacketPtr pkt) const
+{
+    auto state = dynamic_cast<RouteState *>(pkt->senderState);
+    if (state && state->routes == this)
+        return state->port;
+
+    // A component below pushed a sender state without popping it
+    for (auto s = pkt->senderState; s; s = s->predecessor) {
+        auto buried = dynamic_cast<RouteState *>(s);
+        panic_if(buried && buried->routes == this,
+                 "%s: Route of response %s is under a sender state "
+                 "that was not popped\n", name, pkt->print());
+    }
+    panic("%s: No route for response %s\n", name, pkt->print());
+}
+
+void
+XBarRoutes::pop(PacketPtr pkt)
+{
+    assert(routeOf(pkt) != InvalidPortID);
+    freeStates.push_back(static_cast<RouteState *>(pkt->popSenderState()));
+}
+
+} // namespace gem5
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Lookup structures the crossbars route packets with.
+ */
+
+#ifndef __MEM_XBAR_ROUTING_HH__
+#define __MEM_XBAR_ROUTING_HH__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/addr_range_map.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+/**
+ * Direct-mapped cache of the ports found in the port map of a crossbar,
+ * in front of it. The addresses are cached in blocks small enough for
+ * all the addresses of a block to map to the same port: the blocks
+ * never straddle the boundary of a range, nor an interleaving granule.
+ * Only the ranges found in the map are cached, so that the cache needs
+ * resetting when the map changes, but not when the default range does.
+ */
+class XBarPortCache
+{
+  public:
+    typedef AddrRangeMap<PortID, 3> PortMap;
+
+    static constexpr size_t numEntries = 64;
+
+  private:
+    struct Entry
+    {
+        Addr block = MaxAddr;
+        PortID port = InvalidPortID;
+    };
+    std::array<Entry, numEntries> entries;
+
+    /** Log2 of the size of the blocks. */
+    unsigned blockShift = 0;
+
+    /** Number of lookups which hit, for testing. */
+    uint64_t hits = 0;
+
+  public:
+    /**
+     * Empty the cache, and size its blocks after the ranges of a map.
+     * This must be called whenever the map changes.
+     */
+    void reset(const PortMap &port_map);
+
+    /**
+     * Port a range maps to, looked up in the map on a miss.
+     *
+     * @return InvalidPortID if no range of the map holds the range.
+     */
+    PortID find(const AddrRange &addr_range, const PortMap &port_map);
+
+    /** Number of lookups which hit since the last reset. */
+    uint64_t numHits() const { return hits; }
+};
+
+/**
+ * Routes of the requests through a crossbar back to the CPU-side ports
+ * they came from. The route of a request is pushed on its sender state
+ * stack, so that its response finds its way back without a lookup, and
+ * popped from the response. The states are recycled once popped, so that
+ * routing does not allocate memory once the crossbar reaches steady
+ * state.
+ *
+ * This relies on the components below the crossbar popping the sender
+ * states they push before responding, as required by the sender state
+ * stack. The responses breaking this rule are told apart from the ones
+ * that were never routed.
+ */
+class XBarRoutes
+{
+  private:
+    class RouteState : public Packet::SenderState
+    {
+      public:
+        RouteState(const XBarRoutes *_routes) : routes(_routes) {}
+
+        const XBarRoutes *const routes;
+        PortID port = InvalidPortID;
+    };
+
+    /** Name of the crossbar, for the error messages. */
+    const std::string name;
+
+    /** All the route states, and the ones not attached to a packet. */
+    std::vector<std::unique_ptr<RouteState>> states;
+    std::vector<RouteState *> freeStates;
+
+  public:
+    XBarRoutes(const std::string &_name) : name(_name) {}
+
+    /**
+     * Attach the port a request came from to the request.
+     *
+     * @param pkt Request to be routed back to the port.
+     * @param port Port the request came from.
+     */
+    void push(PacketPtr pkt, PortID port);
+
+    /** Port the request of a response came from. */
+    PortID routeOf(PacketPtr pkt) const;
+
+    /** Detach the route of a response, once forwarded. */
+    void pop(PacketPtr pkt);
+
+    /** Number of routes attached to packets. */
+    size_t size() const { return states.size() - freeStates.size(); }
+
+    /** Number of route states allocated so far. */
+    size_t capacity() const { return states.size(); }
+};
+
+} // namespace gem5
+
+#endif // __MEM_XBAR_ROUTING_HH__
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/gtest/logging.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "mem/xbar_routing.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+/** Sender state of a component below the crossbars. */
+struct OtherState : public Packet::SenderState
+{
+};
+
+PacketPtr
+makeRequest(Addr addr)
+{
+    auto req = std::make_shared<Request>(addr, 8, 0, 0);
+    return new Packet(req, MemCmd::ReadReq);
+}
+
+} // anonymous namespace
+
+/** Responses are routed to the port their request came from. */
+TEST(XBarRoutesTest, Route)
+{
+    XBarRoutes routes("xbar");
+    PacketPtr pkts[4];
+    for (int i = 0; i < 4; i++) {
+        pkts[i] = makeRequest(0x1000 * i);
+        routes.push(pkts[i], i + 1);
+    }
+    EXPECT_EQ(routes.size(), 4u);
+
+    // The responses come back in any order
+    for (int i : {2, 0, 3, 1}) {
+        pkts[i]->makeResponse();
+        EXPECT_EQ(routes.routeOf(pkts[i]), i + 1);
+        routes.pop(pkts[i]);
+        EXPECT_EQ(pkts[i]->senderState, nullptr);
+        delete pkts[i];
+    }
+    EXPECT_EQ(routes.size(), 0u);
+}
+
+/** The route states are recycled. */
+TEST(XBarRoutesTest, Recycle)
+{
+    XBarRoutes routes("xbar");
+    for (int i = 0; i < 100; i++) {
+        PacketPtr pkt = makeRequest(0x40 * i);
+        routes.push(pkt, 1);
+        pkt->makeResponse();
+        routes.pop(pkt);
+        delete pkt;
+    }
+    EXPECT_EQ(routes.capacity(), 1u);
+}
+
+/**
+ * Responses crossing two crossbars, with a component below pushing and
+ * popping its own state, are routed by each crossbar in turn.
+ */
+TEST(XBarRoutesTest, Stacked)
+{
+    XBarRoutes upper("upper");
+    XBarRoutes lower("lower");
+    PacketPtr pkt = makeRequest(0x1000);
+    upper.push(pkt, 3);
+    lower.push(pkt, 5);
+    pkt->pushSenderState(new OtherState);
+
+    pkt->makeResponse();
+    delete pkt->popSenderState();
+    EXPECT_EQ(lower.routeOf(pkt), 5);
+    lower.pop(pkt);
+    EXPECT_EQ(upper.routeOf(pkt), 3);
+    upper.pop(pkt);
+    EXPECT_EQ(pkt->senderState, nullptr);
+    delete pkt;
+}
+
+/** A response whose route is under a state left on it is reported. */
+TEST(XBarRoutesTest, StateNotPopped)
+{
+    XBarRoutes routes("xbar");
+    PacketPtr pkt = makeRequest(0x1000);
+    routes.push(pkt, 1);
+    OtherState *other = new OtherState;
+    pkt->pushSenderState(other);
+    pkt->makeResponse();
+
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(routes.routeOf(pkt));
+    EXPECT_NE(gtestLogOutput.str().find("not popped"), std::string::npos);
+
+    delete pkt->popSenderState();
+    routes.pop(pkt);
+    delete pkt;
+}
+
+/** A response which was never routed is reported. */
+TEST(XBarRoutesTest, NoRoute)
+{
+    XBarRoutes routes("xbar");
+    XBarRoutes other("other");
+    PacketPtr pkt = makeRequest(0x1000);
+    other.push(pkt, 1);
+    pkt->makeResponse();
+
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(routes.routeOf(pkt));
+    EXPECT_NE(gtestLogOutput.str().find("No route"), std::string::npos);
+
+    other.pop(pkt);
+    delete pkt;
+}
+
+/** The cache returns the ports of the map, hitting on repeated blocks. */
+TEST(XBarPortCacheTest, Find)
+{
+    XBarPortCache::PortMap map;
+    map.insert(AddrRange(0x0, 0x10000), 0);
+    map.insert(AddrRange(0x10000, 0x18000), 1);
+    XBarPortCache cache;
+    cache.reset(map);
+
+    EXPECT_EQ(cache.find(RangeSize(0x100, 64), map), 0);
+    EXPECT_EQ(cache.numHits(), 0u);
+    EXPECT_EQ(cache.find(RangeSize(0x140, 64), map), 0);
+    EXPECT_EQ(cache.numHits(), 1u);
+    EXPECT_EQ(cache.find(RangeSize(0x10000, 64), map), 1);
+    EXPECT_EQ(cache.find(RangeSize(0x10040, 64), map), 1);
+    EXPECT_EQ(cache.numHits(), 2u);
+
+    // Outside of the map
+    EXPECT_EQ(cache.find(RangeSize(0x18000, 64), map), InvalidPortID);
+    EXPECT_EQ(cache.find(RangeSize(0x18000, 64), map), InvalidPortID);
+    EXPECT_EQ(cache.numHits(), 2u);
+}
+
+/** The blocks of the cache don't straddle the interleaving granules. */
+TEST(XBarPortCacheTest, Interleaved)
+{
+    XBarPortCache::PortMap map;
+    for (int i = 0; i < 4; i++) {
+        map.insert(AddrRange(0x0, 0x100000, {Addr(1) << 8, Addr(1) << 9},
+                             i), i);
+    }
+    XBarPortCache cache;
+    cache.reset(map);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (Addr addr = 0; addr < 0x2000; addr += 64)
+            EXPECT_EQ(cache.find(RangeSize(addr, 64), map),
+                      PortID((addr >> 8) % 4));
+    }
+    EXPECT_GT(cache.numHits(), 0u);
+}
+
+/** After a range change, the cache misses and finds the new port. */
+TEST(XBarPortCacheTest, RangeChange)
+{
+    XBarPortCache::PortMap map;
+    map.insert(AddrRange(0x0, 0x10000), 0);
+    XBarPortCache cache;
+    cache.reset(map);
+    EXPECT_EQ(cache.find(RangeSize(0x8000, 64), map), 0);
+    EXPECT_EQ(cache.find(RangeSize(0x8000, 64), map), 0);
+    EXPECT_EQ(cache.numHits(), 1u);
+
+    // The upper half moves to another port
+    map.erase(map.begin());
+    map.insert(AddrRange(0x0, 0x8000), 0);
+    map.insert(AddrRange(0x8000, 0x10000), 1);
+    cache.reset(map);
+
+    EXPECT_EQ(cache.find(RangeSize(0x8000, 64), map), 1);
+    EXPECT_EQ(cache.numHits(), 0u);
+    EXPECT_EQ(cache.find(RangeSize(0x8000, 64), map), 1);
+    EXPECT_EQ(cache.numHits(), 1u);
+    EXPECT_EQ(cache.find(RangeSize(0x7fc0, 64), map), 0);
+
+    // A range straddling the new boundary is in no range of the map
+    EXPECT_EQ(cache.find(RangeSize(0x7ff0, 32), map), InvalidPortID);
+}
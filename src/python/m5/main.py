@@ -233,6 +233,15 @@ def parse_options():
         callback=_stats_help,
         help="Display documentation for available stat visitors",
     )
+    option(
+        "--host-profile",
+        metavar="PERIOD",
+        type="int",
+        default=0,
+        help="Time one simulated event in PERIOD on average, and write the "
+        "host time spent in each event to hostprofile.txt in the output "
+        "directory [Default: disabled]",
+    )
 
     # Configuration Options
     group("Configuration Options")
@@ -301,6 +310,17 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-flight-recorder",
+        metavar="MB",
+        type="int",
+        default=0,
+        help="Keep the last MB megabytes of debug output of each host "
+        "thread in memory, and only write them to the debug file on exit, "
+        "on a panic or fatal error, or with the m5 dumptrace op. The "
+        "output is much cheaper than when written as it goes "
+        "[Default: disabled]",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -559,6 +579,9 @@ def main():
     # set stats options
     stats.addStatVisitor(options.stats_file)
 
+    if options.host_profile:
+        event.enableHostProfiler(options.host_profile)
+
     # Disable listeners unless running interactively or explicitly
     # enabled
     if options.listener_mode == "off":
@@ -612,6 +635,10 @@ def main():
 
     trace.output(options.debug_file)
 
+    if options.debug_flight_recorder:
+        _check_tracing()
+        trace.flightRecorder(options.debug_flight_recorder * 1024 * 1024)
+
     for activate in options.debug_activate:
         _check_tracing()
         trace.activate(activate)
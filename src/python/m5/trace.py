@@ -28,7 +28,9 @@
 from _m5.trace import (
     activate,
     disable,
+    dumpFlightRecorder,
     enable,
+    flightRecorder,
     ignore,
     output,
 )
@@ -48,7 +48,9 @@
 #include "base/compiler.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +69,20 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+flightRecorder(size_t size)
+{
+    trace::setDebugLogger(
+        new trace::FlightRecorderLogger(size, trace::getDebugLogger()));
+
+    static bool hooked = false;
+    if (!hooked) {
+        registerExitCallback(trace::dumpFlightRecorder);
+        Logger::addExitHook(trace::dumpFlightRecorder);
+        hooked = true;
+    }
+}
+
 static void
 activate(const char *expr)
 {
@@ -129,6 +145,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("flightRecorder", &flightRecorder)
+        .def("dumpFlightRecorder", &trace::dumpFlightRecorder)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
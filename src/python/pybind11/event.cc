@@ -44,7 +44,10 @@
 #include "pybind11/stl.h"
 
 #include "base/logging.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
 #include "sim/eventq.hh"
+#include "sim/host_profiler.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
 #include "sim/simulate.hh"
@@ -100,6 +103,26 @@ class PyEvent : public Event
     }
 };
 
+/**
+ * Profiles the host time spent in the events, and writes the profile to
+ * hostprofile.txt in the output directory on exit.
+ */
+void
+enableHostProfiler(unsigned period)
+{
+    static bool registered = false;
+
+    HostProfiler::enable(period);
+    if (!registered) {
+        registered = true;
+        registerExitCallback([]() {
+            OutputStream *os = simout.create("hostprofile.txt");
+            HostProfiler::dump(*os->stream());
+            simout.close(os);
+        });
+    }
+}
+
 void
 pybind_init_event(py::module_ &m_native)
 {
@@ -111,6 +134,7 @@ pybind_init_event(py::module_ &m_native)
     m.def("getMaxTick", &get_max_tick, py::return_value_policy::copy);
     m.def("terminateEventQueueThreads", &terminateEventQueueThreads);
     m.def("exitSimLoop", &exitSimLoop);
+    m.def("enableHostProfiler", &enableHostProfiler, py::arg("period"));
     m.def("getEventQueue", []() { return curEventQueue(); },
           py::return_value_policy::reference);
     m.def("setEventQueue", [](EventQueue *q) { return curEventQueue(q); });
@@ -49,6 +49,15 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+# Format of the files holding the backing stores in checkpoints. The page
+# formats only store the pages which are not full of zeros, and the pages
+# with the same contents once. Uncompressed pages are mapped from the
+# file when restoring, so that the host only reads the pages the
+# simulation accesses.
+class MemoryCheckpointFormat(Enum):
+    vals = ["gzip", "pages", "compressed_pages"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -79,6 +88,20 @@ class System(SimObject):
         False, "mmap the backing store without reserving swap"
     )
 
+    # The backing store can also be made sparse: it is then mapped
+    # without reserving swap, backed by transparent huge pages when the
+    # host supports them, and only the parts of it the host populated are
+    # read when checkpointing. This lets many systems with large memories
+    # run side by side on a host with memory for their footprints only.
+    sparse_backstore = Param.Bool(
+        False,
+        "Populate the backing store lazily, with transparent huge pages, "
+        "and only checkpoint its populated parts",
+    )
+    memory_checkpoint_format = Param.MemoryCheckpointFormat(
+        "gzip", "Format of the backing stores in checkpoints"
+    )
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
@@ -31,6 +31,7 @@
 #include "sim/eventq.hh"
 
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -246,7 +247,17 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (GEM5_UNLIKELY(HostProfiler::enabled()) &&
+                hostProfiler.sample()) {
+            const auto start = std::chrono::steady_clock::now();
+            event->process();
+            const auto host_time = std::chrono::steady_clock::now() - start;
+            hostProfiler.record(event->name(), event->description(),
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    host_time).count());
+        } else {
+            event->process();
+        }
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
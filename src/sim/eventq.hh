@@ -53,6 +53,7 @@
 #include "base/uncontended_mutex.hh"
 #include "debug/Event.hh"
 #include "sim/cur_tick.hh"
+#include "sim/host_profiler.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
@@ -649,6 +650,9 @@ class EventQueue
      */
     UncontendedMutex service_mutex;
 
+    //! Host time spent in the events, when profiling is enabled.
+    HostProfiler hostProfiler;
+
     //! Insert / remove event from the queue. Should only be called
     //! by thread operating this queue.
     void insert(Event *event);
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the event host time profiler.
+ */
+
+#include "sim/host_profiler.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "base/cprintf.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/**
+ * Profilers of all the event queues, guarded by profilersMutex. Event
+ * queues may be created during static initialization.
+ */
+std::vector<HostProfiler *> &
+profilers()
+{
+    static std::vector<HostProfiler *> list;
+    return list;
+}
+
+std::mutex &
+profilersMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::atomic<uint64_t> nextSeed{0x9e3779b97f4a7c15ULL};
+
+} // anonymous namespace
+
+unsigned HostProfiler::_period = 0;
+
+void
+HostProfiler::enable(unsigned period)
+{
+    _period = period;
+}
+
+HostProfiler::HostProfiler()
+    : randomState(nextSeed.fetch_add(0x9e3779b97f4a7c15ULL) | 1)
+{
+    std::lock_guard<std::mutex> lock(profilersMutex());
+    profilers().push_back(this);
+}
+
+HostProfiler::~HostProfiler()
+{
+    std::lock_guard<std::mutex> lock(profilersMutex());
+    auto &list = profilers();
+    list.erase(std::find(list.begin(), list.end(), this));
+}
+
+unsigned
+HostProfiler::nextInterval()
+{
+    if (_period == 1)
+        return 1;
+
+    // xorshift64, good enough to break the alignment with periodic events
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return 1 + randomState % (2 * _period - 1);
+}
+
+void
+HostProfiler::record(const std::string &name, const char *description,
+                     uint64_t host_ns)
+{
+    // Events that do not override name() are named after their instance
+    const bool unnamed = name.compare(0, 6, "Event_") == 0;
+    std::string key = unnamed ? "Event" : name;
+    key += '\0';
+    key += description;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry &entry = entries[key];
+    if (entry.samples == 0)
+        entry.description = description;
+    entry.samples++;
+    entry.hostNs += host_ns;
+}
+
+void
+HostProfiler::dump(std::ostream &os)
+{
+    struct Row
+    {
+        std::string name;
+        const Entry *entry;
+    };
+
+    // Merge the profiles of the queues
+    std::unordered_map<std::string, Entry> merged;
+    {
+        std::lock_guard<std::mutex> lock(profilersMutex());
+        for (auto *profiler : profilers()) {
+            std::lock_guard<std::mutex> profiler_lock(profiler->mutex);
+            for (const auto &[key, entry] : profiler->entries) {
+                Entry &total = merged[key];
+                total.description = entry.description;
+                total.samples += entry.samples;
+                total.hostNs += entry.hostNs;
+            }
+        }
+    }
+
+    std::vector<Row> rows;
+    uint64_t samples = 0;
+    uint64_t host_ns = 0;
+    for (const auto &[key, entry] : merged) {
+        rows.push_back({key.substr(0, key.find('\0')), &entry});
+        samples += entry.samples;
+        host_ns += entry.hostNs;
+    }
+    std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+        return a.entry->hostNs != b.entry->hostNs ?
+            a.entry->hostNs > b.entry->hostNs : a.name < b.name;
+    });
+
+    const unsigned period = std::max(_period, 1U);
+    ccprintf(os, "Host time spent processing events, one event in %d "
+             "timed on average\n", period);
+    ccprintf(os, "Sampled events: %d, estimated host time: %.3f s\n\n",
+             samples, host_ns * period / 1e9);
+    ccprintf(os, "%4s %12s %7s %14s %10s  %s (%s)\n", "Rank",
+             "Host time(s)", "Share", "Events", "ns/event", "Event",
+             "description");
+
+    unsigned rank = 0;
+    for (const auto &row : rows) {
+        const Entry &entry = *row.entry;
+        ccprintf(os, "%4d %12.3f %6.2f%% %14d %10.1f  %s (%s)\n", ++rank,
+                 entry.hostNs * period / 1e9,
+                 host_ns ? 100.0 * entry.hostNs / host_ns : 0.0,
+                 entry.samples * period,
+                 double(entry.hostNs) / entry.samples, row.name,
+                 entry.description);
+    }
+}
+
+} // namespace gem5
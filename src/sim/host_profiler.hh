@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Sampling profiler of the host time spent processing events.
+ */
+
+#ifndef __SIM_HOST_PROFILER_HH__
+#define __SIM_HOST_PROFILER_HH__
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+/**
+ * Attributes the host time spent in Event::process() to the events, by
+ * their name, which starts with the name of the SimObject they belong to,
+ * and their description.
+ *
+ * Each event queue owns a profiler. Timing an event costs a couple of
+ * clock reads and a hash table update, so only one event in a period is
+ * timed on average, the gap between two sampled events being drawn at
+ * random to avoid aliasing with periodic events. The host time and the
+ * number of events of each name are estimated from the samples.
+ *
+ * The profiles of all the queues are written, ranked by host time, to
+ * hostprofile.txt in the output directory when the simulator exits.
+ */
+class HostProfiler
+{
+  public:
+    /**
+     * Starts or stops profiling.
+     *
+     * @param period Average number of events between two sampled events,
+     *               1 to time all the events, 0 to stop profiling.
+     */
+    static void enable(unsigned period);
+
+    static bool enabled() { return _period != 0; }
+
+    /** Writes the ranked profile of all the event queues. */
+    static void dump(std::ostream &os);
+
+    HostProfiler();
+    ~HostProfiler();
+
+    /** Counts an event, and returns whether it should be timed. */
+    bool
+    sample()
+    {
+        if (GEM5_LIKELY(--countdown != 0))
+            return false;
+        countdown = nextInterval();
+        return true;
+    }
+
+    /** Records the host time spent processing a sampled event. */
+    void record(const std::string &name, const char *description,
+                uint64_t host_ns);
+
+  private:
+    struct Entry
+    {
+        std::string description;
+        uint64_t samples = 0;
+        uint64_t hostNs = 0;
+    };
+
+    /** Number of events until the next sample, up to twice the period. */
+    unsigned nextInterval();
+
+    static unsigned _period;
+
+    unsigned countdown = 1;
+    uint64_t randomState;
+
+    /** Samples by event name and description, guarded by mutex. */
+    std::unordered_map<std::string, Entry> entries;
+    std::mutex mutex;
+};
+
+} // namespace gem5
+
+#endif // __SIM_HOST_PROFILER_HH__
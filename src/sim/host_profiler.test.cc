@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sim/host_profiler.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Lines of the profile table, without the two header lines. */
+std::vector<std::string>
+dumpRows()
+{
+    std::stringstream ss;
+    HostProfiler::dump(ss);
+
+    std::vector<std::string> rows;
+    std::string line;
+    while (std::getline(ss, line)) {
+        if (line.find("Rank") == std::string::npos &&
+                line.find(" (") != std::string::npos) {
+            rows.push_back(line);
+        }
+    }
+    return rows;
+}
+
+} // anonymous namespace
+
+/** With a period of 1, every event is sampled. */
+TEST(HostProfilerTest, SampleAll)
+{
+    HostProfiler::enable(1);
+    HostProfiler profiler;
+    for (int i = 0; i < 10; i++)
+        ASSERT_TRUE(profiler.sample());
+    HostProfiler::enable(0);
+}
+
+/** The sampling intervals average to the period. */
+TEST(HostProfilerTest, SamplePeriod)
+{
+    HostProfiler::enable(16);
+    HostProfiler profiler;
+    int samples = 0;
+    const int events = 160000;
+    for (int i = 0; i < events; i++)
+        samples += profiler.sample();
+    EXPECT_NEAR(samples, events / 16, events / 16 / 10);
+    HostProfiler::enable(0);
+}
+
+/** Events are ranked by host time, and queues are merged. */
+TEST(HostProfilerTest, DumpRanked)
+{
+    HostProfiler::enable(1);
+    {
+        HostProfiler queue0;
+        HostProfiler queue1;
+        queue0.record("system.cpu.tickEvent", "Tick", 100);
+        queue0.record("system.mem.respondEvent", "Respond", 50);
+        queue1.record("system.mem.respondEvent", "Respond", 100);
+        queue1.record("Event_12", "generic", 10);
+        queue1.record("Event_13", "generic", 10);
+
+        auto rows = dumpRows();
+        ASSERT_EQ(rows.size(), 3u);
+        EXPECT_NE(rows[0].find("system.mem.respondEvent (Respond)"),
+                  std::string::npos);
+        EXPECT_NE(rows[0].find(" 2 "), std::string::npos);
+        EXPECT_NE(rows[1].find("system.cpu.tickEvent (Tick)"),
+                  std::string::npos);
+        // Events without a name are gathered by description
+        EXPECT_NE(rows[2].find("Event (generic)"), std::string::npos);
+    }
+
+    // Destroyed profilers are no longer dumped
+    EXPECT_TRUE(dumpRows().empty());
+    HostProfiler::enable(0);
+}
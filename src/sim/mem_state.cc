@@ -29,6 +29,7 @@
 #include "sim/mem_state.hh"
 
 #include <cassert>
+#include <iterator>
 
 #include "arch/generic/mmu.hh"
 #include "debug/Vma.hh"
@@ -67,7 +68,8 @@ MemState::operator=(const MemState &in)
     _stackMin = in._stackMin;
     _nextThreadStackBase = in._nextThreadStackBase;
     _mmapEnd = in._mmapEnd;
-    _vmaList = in._vmaList; /* This assignment does a deep copy. */
+    _vmas = in._vmas; /* This assignment does a deep copy. */
+    _lastFaultVma = nullptr;
 
     return *this;
 }
@@ -78,15 +80,94 @@ MemState::resetOwner(Process *owner)
     _ownerProcess = owner;
 }
 
+MemState::VmaMap::iterator
+MemState::firstVmaEndingAfter(Addr addr)
+{
+    auto it = _vmas.upper_bound(addr);
+    if (it != _vmas.begin() && std::prev(it)->second.end() > addr)
+        --it;
+    return it;
+}
+
+std::vector<VMA>
+MemState::extractVmas(Addr start_addr, Addr end_addr)
+{
+    const AddrRange range(start_addr, end_addr);
+    std::vector<VMA> extracted;
+    _lastFaultVma = nullptr;
+
+    auto it = firstVmaEndingAfter(start_addr);
+    while (it != _vmas.end() && it->first < end_addr) {
+        VMA &vma = it->second;
+        if (vma.isStrictSuperset(range)) {
+            DPRINTF(Vma, "memstate: split vma [0x%x - 0x%x] into "
+                    "[0x%x - 0x%x] and [0x%x - 0x%x]\n",
+                    vma.start(), vma.end(),
+                    vma.start(), start_addr,
+                    end_addr, vma.end());
+            /**
+             * Need to split into three regions, keeping the left one in
+             * place.
+             */
+            VMA right = vma;
+            right.sliceRegionLeft(end_addr);
+            extracted.push_back(vma);
+            extracted.back().sliceRegionLeft(start_addr);
+            extracted.back().sliceRegionRight(end_addr);
+            vma.sliceRegionRight(start_addr);
+            _vmas.emplace(end_addr, std::move(right));
+
+            /**
+             * Region cannot be in any more VMA, because it is completely
+             * contained in this one!
+             */
+            break;
+        } else if (vma.isSubset(range)) {
+            DPRINTF(Vma, "memstate: destroying vma [0x%x - 0x%x]\n",
+                    vma.start(), vma.end());
+            extracted.push_back(std::move(vma));
+            it = _vmas.erase(it);
+        } else if (vma.start() < start_addr) {
+            DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
+                    "into [0x%x - 0x%x]\n",
+                    vma.start(), vma.end(),
+                    vma.start(), start_addr);
+            /**
+             * Overlaps from the right.
+             */
+            extracted.push_back(vma);
+            extracted.back().sliceRegionLeft(start_addr);
+            vma.sliceRegionRight(start_addr);
+            ++it;
+        } else {
+            DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
+                    "into [0x%x - 0x%x]\n",
+                    vma.start(), vma.end(),
+                    end_addr, vma.end());
+            /**
+             * Overlaps from the left, so this is the last VMA in the
+             * range. Its start moves, and so does its key.
+             */
+            auto node = _vmas.extract(it);
+            extracted.push_back(node.mapped());
+            extracted.back().sliceRegionRight(end_addr);
+            node.mapped().sliceRegionLeft(end_addr);
+            node.key() = end_addr;
+            _vmas.insert(std::move(node));
+            break;
+        }
+    }
+
+    return extracted;
+}
+
 bool
 MemState::isUnmapped(Addr start_addr, Addr length)
 {
     Addr end_addr = start_addr + length;
-    const AddrRange range(start_addr, end_addr);
-    for (const auto &vma : _vmaList) {
-        if (vma.intersects(range))
-            return false;
-    }
+    auto it = firstVmaEndingAfter(start_addr);
+    if (it != _vmas.end() && it->first < end_addr)
+        return false;
 
     /**
      * In case someone skips the VMA interface and just directly maps memory
@@ -140,9 +221,8 @@ MemState::updateBrkRegion(Addr old_brk, Addr new_brk)
      * for the extra memory that is requested so we do not create a situation
      * where there can be overlapping mappings in the regions.
      *
-     * Since we do not track the type of the region and we also do not
-     * coalesce the regions together, we can create a fragmented set of
-     * heap regions.
+     * The new mapping is merged by mapRegion() with the heap region it
+     * extends, so the heap stays a single region as it grows.
      */
     if (page_aligned_new_brk > page_aligned_old_brk) {
         auto length = page_aligned_new_brk - page_aligned_old_brk;
@@ -156,11 +236,8 @@ MemState::updateBrkRegion(Addr old_brk, Addr new_brk)
         }
 
         /**
-         * Note that the heap regions are always contiguous but there is
-         * no mechanism right now to coalesce together memory that belongs
-         * to the same region with similar access permissions. This could be
-         * implemented if it actually becomes necessary; probably only
-         * necessary if the list becomes too long to walk.
+         * The heap regions are always contiguous, and anonymous, so
+         * mapRegion() coalesces this one with the previous heap region.
          */
         mapRegion(page_aligned_old_brk, length, "heap");
     }
@@ -181,81 +258,49 @@ MemState::mapRegion(Addr start_addr, Addr length,
      */
     assert(isUnmapped(start_addr, length));
 
+    Addr end_addr = start_addr + length;
+    _lastFaultVma = nullptr;
+
     /**
-     * Record the region in our list structure.
+     * Anonymous regions are merged with the anonymous regions of the same
+     * name they touch, so that e.g. the heap stays a single region as it
+     * grows.
      */
-    _vmaList.emplace_back(AddrRange(start_addr, start_addr + length),
-                          _pageBytes, region_name, sim_fd, offset);
+    if (sim_fd == -1) {
+        auto mergeable = [&region_name](const VMA &vma) {
+            return !vma.hasHostBuf() && vma.getName() == region_name;
+        };
+
+        auto next = _vmas.lower_bound(start_addr);
+        if (next != _vmas.end() && next->first == end_addr &&
+                mergeable(next->second)) {
+            end_addr = next->second.end();
+            next = _vmas.erase(next);
+        }
+        if (next != _vmas.begin()) {
+            auto prev = std::prev(next);
+            if (prev->second.end() == start_addr &&
+                    mergeable(prev->second)) {
+                start_addr = prev->first;
+                _vmas.erase(prev);
+            }
+        }
+    }
+
+    /**
+     * Record the region in our map structure.
+     */
+    _vmas.emplace(std::piecewise_construct,
+                  std::forward_as_tuple(start_addr),
+                  std::forward_as_tuple(AddrRange(start_addr, end_addr),
+                                        _pageBytes, region_name, sim_fd,
+                                        offset));
 }
 
 void
 MemState::unmapRegion(Addr start_addr, Addr length)
 {
-    Addr end_addr = start_addr + length;
-    const AddrRange range(start_addr, end_addr);
-
-    auto vma = std::begin(_vmaList);
-    while (vma != std::end(_vmaList)) {
-        if (vma->isStrictSuperset(range)) {
-            DPRINTF(Vma, "memstate: split vma [0x%x - 0x%x] into "
-                    "[0x%x - 0x%x] and [0x%x - 0x%x]\n",
-                    vma->start(), vma->end(),
-                    vma->start(), start_addr,
-                    end_addr, vma->end());
-            /**
-             * Need to split into two smaller regions.
-             * Create a clone of the old VMA and slice it to the right.
-             */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionRight(start_addr);
-
-            /**
-             * Slice old VMA to encapsulate the left region.
-             */
-            vma->sliceRegionLeft(end_addr);
-
-            /**
-             * Region cannot be in any more VMA, because it is completely
-             * contained in this one!
-             */
-            break;
-        } else if (vma->isSubset(range)) {
-            DPRINTF(Vma, "memstate: destroying vma [0x%x - 0x%x]\n",
-                    vma->start(), vma->end());
-            /**
-             * Need to nuke the existing VMA.
-             */
-            vma = _vmaList.erase(vma);
-
-            continue;
-
-        } else if (vma->intersects(range)) {
-            /**
-             * Trim up the existing VMA.
-             */
-            if (vma->start() < start_addr) {
-                DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
-                        "into [0x%x - 0x%x]\n",
-                        vma->start(), vma->end(),
-                        vma->start(), start_addr);
-                /**
-                 * Overlaps from the right.
-                 */
-                vma->sliceRegionRight(start_addr);
-            } else {
-                DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
-                        "into [0x%x - 0x%x]\n",
-                        vma->start(), vma->end(),
-                        end_addr, vma->end());
-                /**
-                 * Overlaps from the left.
-                 */
-                vma->sliceRegionLeft(end_addr);
-            }
-        }
-
-        vma++;
-    }
+    extractVmas(start_addr, start_addr + length);
 
     /**
      * TLBs need to be flushed to remove any stale mappings from regions
@@ -288,74 +333,15 @@ MemState::unmapRegion(Addr start_addr, Addr length)
 void
 MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
 {
-    Addr end_addr = start_addr + length;
-    const AddrRange range(start_addr, end_addr);
-
-    auto vma = std::begin(_vmaList);
-    while (vma != std::end(_vmaList)) {
-        if (vma->isStrictSuperset(range)) {
-            /**
-             * Create clone of the old VMA and slice right.
-             */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionRight(start_addr);
-
-            /**
-             * Create clone of the old VMA and slice it left.
-             */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionLeft(end_addr);
-
-            /**
-             * Slice the old VMA left and right to adjust the file backing,
-             * then overwrite the virtual addresses!
-             */
-            vma->sliceRegionLeft(start_addr);
-            vma->sliceRegionRight(end_addr);
-            vma->remap(new_start_addr);
-
-            /**
-             * The region cannot be in any more VMAs, because it is
-             * completely contained in this one!
-             */
-            break;
-        } else if (vma->isSubset(range)) {
-            /**
-             * Just go ahead and remap it!
-             */
-            vma->remap(vma->start() - start_addr + new_start_addr);
-        } else if (vma->intersects(range)) {
-            /**
-             * Create a clone of the old VMA.
-             */
-            _vmaList.push_back(*vma);
-
-            if (vma->start() < start_addr) {
-                /**
-                 * Overlaps from the right.
-                 */
-                _vmaList.back().sliceRegionRight(start_addr);
-
-                /**
-                 * Remap the old region.
-                 */
-                vma->sliceRegionLeft(start_addr);
-                vma->remap(new_start_addr);
-            } else {
-                /**
-                 * Overlaps from the left.
-                 */
-                _vmaList.back().sliceRegionLeft(end_addr);
-
-                /**
-                 * Remap the old region.
-                 */
-                vma->sliceRegionRight(end_addr);
-                vma->remap(new_start_addr + vma->start() - start_addr);
-            }
-        }
-
-        vma++;
+    /**
+     * Take the parts of the VMAs in the range out, clear their
+     * destination and put them back at their new address.
+     */
+    auto moved = extractVmas(start_addr, start_addr + length);
+    extractVmas(new_start_addr, new_start_addr + length);
+    for (auto &vma : moved) {
+        vma.remap(vma.start() - start_addr + new_start_addr);
+        _vmas.emplace(vma.start(), std::move(vma));
     }
 
     /**
@@ -395,31 +381,36 @@ MemState::fixupFault(Addr vaddr)
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
      */
-    for (const auto &vma : _vmaList) {
-        if (vma.contains(vaddr)) {
-            Addr vpage_start = roundDown(vaddr, _pageBytes);
-            _ownerProcess->allocateMem(vpage_start, _pageBytes);
+    const VMA *vma = _lastFaultVma;
+    if (!vma || !vma->contains(vaddr)) {
+        auto it = firstVmaEndingAfter(vaddr);
+        vma = it != _vmas.end() && it->second.contains(vaddr) ?
+            &it->second : nullptr;
+    }
+    if (vma) {
+        _lastFaultVma = vma;
+        Addr vpage_start = roundDown(vaddr, _pageBytes);
+        _ownerProcess->allocateMem(vpage_start, _pageBytes);
 
+        /**
+         * We are assuming that fresh pages are zero-filled, so there is
+         * no need to zero them out when there is no backing file.
+         * This assumption will not hold true if/when physical pages
+         * are recycled.
+         */
+        if (vma->hasHostBuf()) {
             /**
-             * We are assuming that fresh pages are zero-filled, so there is
-             * no need to zero them out when there is no backing file.
-             * This assumption will not hold true if/when physical pages
-             * are recycled.
+             * Write the memory for the host buffer contents for all
+             * ThreadContexts associated with this process.
              */
-            if (vma.hasHostBuf()) {
-                /**
-                 * Write the memory for the host buffer contents for all
-                 * ThreadContexts associated with this process.
-                 */
-                for (auto &cid : _ownerProcess->contextIds) {
-                    auto *tc = _ownerProcess->system->threads[cid];
-                    SETranslatingPortProxy
-                        virt_mem(tc, SETranslatingPortProxy::Always);
-                    vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
-                }
+            for (auto &cid : _ownerProcess->contextIds) {
+                auto *tc = _ownerProcess->system->threads[cid];
+                SETranslatingPortProxy
+                    virt_mem(tc, SETranslatingPortProxy::Always);
+                vma->fillMemPages(vpage_start, _pageBytes, virt_mem);
             }
-            return true;
         }
+        return true;
     }
 
     /**
@@ -486,7 +477,7 @@ MemState::printVmaList()
 {
     std::stringstream file_content;
 
-    for (auto vma : _vmaList) {
+    for (const auto &[start, vma] : _vmas) {
         std::stringstream line;
         line << std::hex << vma.start() << "-";
         line << std::hex << vma.end() << " ";
@@ -32,9 +32,11 @@
 #include <fcntl.h>
 #include <unistd.h>
 
-#include <list>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "debug/Vma.hh"
@@ -197,9 +199,9 @@ class MemState : public Serializable
         paramOut(cp, "mmapEnd", _mmapEnd);
 
         ScopedCheckpointSection sec(cp, "vmalist");
-        paramOut(cp, "size", _vmaList.size());
+        paramOut(cp, "size", _vmas.size());
         int count = 0;
-        for (auto vma : _vmaList) {
+        for (const auto &[start, vma] : _vmas) {
             ScopedCheckpointSection sec(cp, csprintf("Vma%d", count++));
             paramOut(cp, "name", vma.getName());
             if (vma.hasHostBuf()) {
@@ -240,10 +242,14 @@ class MemState : public Serializable
             }
             paramIn(cp, "addrRangeStart", start);
             paramIn(cp, "addrRangeEnd", end);
-            _vmaList.emplace_back(AddrRange(start, end), _pageBytes, name,
-                                  host_fd, offset);
+            _vmas.emplace(std::piecewise_construct,
+                          std::forward_as_tuple(start),
+                          std::forward_as_tuple(AddrRange(start, end),
+                                                _pageBytes, name, host_fd,
+                                                offset));
             close(host_fd);
         }
+        _lastFaultVma = nullptr;
     }
 
     /**
@@ -252,6 +258,21 @@ class MemState : public Serializable
     std::string printVmaList();
 
   private:
+    typedef std::map<Addr, VMA> VmaMap;
+
+    /**
+     * Find the first VMA ending after an address.
+     */
+    VmaMap::iterator firstVmaEndingAfter(Addr addr);
+
+    /**
+     * Remove an address range from the VMAs, splitting the VMAs which
+     * cross its bounds.
+     *
+     * @return The parts of the VMAs within the range, in address order.
+     */
+    std::vector<VMA> extractVmas(Addr start_addr, Addr end_addr);
+
     /**
      * @param
      */
@@ -278,18 +299,22 @@ class MemState : public Serializable
     Addr _mmapEnd;
 
     /**
-     * The _vmaList member is a list of virtual memory areas in the target
-     * application space that have been allocated by the target. In most
-     * operating systems, lazy allocation is used and these structures (or
-     * equivalent ones) are used to track the valid address ranges.
+     * The _vmas member holds the virtual memory areas in the target
+     * application space that have been allocated by the target, by start
+     * address. In most operating systems, lazy allocation is used and
+     * these structures (or equivalent ones) are used to track the valid
+     * address ranges.
      *
-     * This could use a more efficient data structure like an interval
-     * tree, but it is unclear whether the vmas will be modified often enough
-     * for the improvement in lookup time to matter. Unmapping VMAs currently
-     * modifies the list while iterating so the STL container must either
-     * support this or the unmapping method must be changed.
+     * The VMAs never overlap, so the VMA containing an address is the
+     * last one starting at or below it.
+     */
+    VmaMap _vmas;
+
+    /**
+     * The VMA of the last fault fixed up, as faults tend to hit the same
+     * region. Reset whenever the VMAs change.
      */
-    std::list<VMA> _vmaList;
+    const VMA *_lastFaultVma = nullptr;
 };
 
 } // namespace gem5
@@ -53,6 +53,7 @@
 
 #include "base/debug.hh"
 #include "base/output.hh"
+#include "base/trace.hh"
 #include "cpu/base.hh"
 #include "cpu/thread_context.hh"
 #include "debug/Loader.hh"
@@ -467,6 +468,13 @@ debugbreak(ThreadContext *tc)
     debug::breakpoint();
 }
 
+void
+dumptrace(ThreadContext *tc)
+{
+    DPRINTF(PseudoInst, "pseudo_inst::dumptrace()\n");
+    trace::dumpFlightRecorder();
+}
+
 void
 switchcpu(ThreadContext *tc)
 {
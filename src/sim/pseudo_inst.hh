@@ -107,6 +107,7 @@ void dumpstats(ThreadContext *tc, Tick delay, Tick period);
 void dumpresetstats(ThreadContext *tc, Tick delay, Tick period);
 void m5checkpoint(ThreadContext *tc, Tick delay, Tick period);
 void debugbreak(ThreadContext *tc);
+void dumptrace(ThreadContext *tc);
 void switchcpu(ThreadContext *tc);
 void workbegin(ThreadContext *tc, uint64_t workid, uint64_t threadid);
 void workend(ThreadContext *tc, uint64_t workid, uint64_t threadid);
@@ -214,6 +215,10 @@ pseudoInstWork(ThreadContext *tc, uint8_t func, uint64_t &result)
         invokeSimcall<ABI>(tc, debugbreak);
         return true;
 
+      case M5OP_DUMP_TRACE:
+        invokeSimcall<ABI>(tc, dumptrace);
+        return true;
+
       case M5OP_SWITCH_CPU:
         invokeSimcall<ABI>(tc, switchcpu);
         return true;
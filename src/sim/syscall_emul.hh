@@ -2101,11 +2101,14 @@ pread64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
+    SETranslatingPortProxy prox(tc);
+    HostBufferArg buf_arg(prox, bufPtr, nbytes, true);
+    const auto &iov = buf_arg.iovecs();
 
-    int bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    int bytes_read = preadv(sim_fd, iov.data(), iov.size(), offset);
 
-    bufArg.copyOut(SETranslatingPortProxy(tc));
+    if (bytes_read > 0)
+        buf_arg.copyOut(bytes_read);
 
     return (bytes_read == -1) ? -errno : bytes_read;
 }
@@ -2122,10 +2125,12 @@ pwrite64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
-    bufArg.copyIn(SETranslatingPortProxy(tc));
+    SETranslatingPortProxy prox(tc);
+    HostBufferArg buf_arg(prox, bufPtr, nbytes, false);
+    buf_arg.copyIn();
+    const auto &iov = buf_arg.iovecs();
 
-    int bytes_written = pwrite(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    int bytes_written = pwritev(sim_fd, iov.data(), iov.size(), offset);
 
     return (bytes_written == -1) ? -errno : bytes_written;
 }
@@ -2762,11 +2767,13 @@ readFunc(SyscallDesc *desc, ThreadContext *tc,
         && !(hbfdp->getFlags() & OS::TGT_O_NONBLOCK))
         return SyscallReturn::retry();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    int bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
+    SETranslatingPortProxy prox(tc);
+    HostBufferArg buf_arg(prox, buf_ptr, nbytes, true);
+    const auto &iov = buf_arg.iovecs();
+    int bytes_read = readv(sim_fd, iov.data(), iov.size());
 
     if (bytes_read > 0)
-        buf_arg.copyOut(SETranslatingPortProxy(tc));
+        buf_arg.copyOut(bytes_read);
 
     return (bytes_read == -1) ? -errno : bytes_read;
 }
@@ -2783,8 +2790,10 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = hbfdp->getSimFD();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    buf_arg.copyIn(SETranslatingPortProxy(tc));
+    SETranslatingPortProxy prox(tc);
+    HostBufferArg buf_arg(prox, buf_ptr, nbytes, false);
+    buf_arg.copyIn();
+    const auto &iov = buf_arg.iovecs();
 
     struct pollfd pfd;
     pfd.fd = sim_fd;
@@ -2802,7 +2811,7 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
             return SyscallReturn::retry();
     }
 
-    int bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    int bytes_written = writev(sim_fd, iov.data(), iov.size());
 
     if (bytes_written != -1)
         fsync(sim_fd);
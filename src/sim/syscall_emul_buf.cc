@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of the syscall buffers accessed in place.
+ */
+
+#include "sim/syscall_emul_buf.hh"
+
+#include <algorithm>
+#include <climits>
+
+namespace gem5
+{
+
+HostBufferArg::HostBufferArg(const TranslatingPortProxy &_proxy, Addr addr,
+                             uint64_t size, bool write)
+    : proxy(_proxy)
+{
+    Addr chunk_addr = addr;
+    bool translated = proxy.tryHostBlob(addr, size, write,
+        [this, &chunk_addr](uint8_t *host, uint64_t chunk_size) {
+            addChunk(chunk_addr, host, chunk_size);
+            chunk_addr += chunk_size;
+    });
+
+    // If part of the buffer can't be translated, let the proxy report it
+    // when copying. The system calls take at most IOV_MAX iovecs.
+    if (!translated || iov.size() > IOV_MAX) {
+        iov.clear();
+        chunks.clear();
+        addChunk(addr, nullptr, size);
+    }
+
+    uint64_t bounce_size = 0;
+    for (size_t i = 0; i < iov.size(); i++) {
+        if (!chunks[i].inPlace)
+            bounce_size += iov[i].iov_len;
+    }
+    if (!bounce_size)
+        return;
+
+    bounce.reset(new uint8_t[bounce_size]);
+    uint8_t *p = bounce.get();
+    for (size_t i = 0; i < iov.size(); i++) {
+        if (!chunks[i].inPlace) {
+            iov[i].iov_base = p;
+            p += iov[i].iov_len;
+        }
+    }
+}
+
+void
+HostBufferArg::addChunk(Addr addr, uint8_t *host, uint64_t size)
+{
+    const bool in_place = host;
+    if (!iov.empty() && chunks.back().inPlace == in_place) {
+        auto &last = iov.back();
+        // Chunks copied through the proxy are contiguous in the target
+        // address space, and so in the bounce buffer
+        if (!in_place ||
+                static_cast<uint8_t *>(last.iov_base) + last.iov_len == host) {
+            last.iov_len += size;
+            return;
+        }
+    }
+    iov.push_back({host, size});
+    chunks.push_back({addr, in_place});
+}
+
+bool
+HostBufferArg::copyIn()
+{
+    for (size_t i = 0; i < iov.size(); i++) {
+        if (!chunks[i].inPlace)
+            proxy.readBlob(chunks[i].addr, iov[i].iov_base, iov[i].iov_len);
+    }
+    return true;    // no EFAULT detection for now
+}
+
+bool
+HostBufferArg::copyOut(uint64_t size)
+{
+    for (size_t i = 0; i < iov.size() && size; i++) {
+        uint64_t len = std::min<uint64_t>(size, iov[i].iov_len);
+        if (!chunks[i].inPlace)
+            proxy.writeBlob(chunks[i].addr, iov[i].iov_base, len);
+        size -= len;
+    }
+    return true;    // no EFAULT detection for now
+}
+
+} // namespace gem5
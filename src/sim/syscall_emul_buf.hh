@@ -35,7 +35,11 @@
 /// This file defines buffer classes used to handle pointer arguments
 /// in emulated syscalls.
 
+#include <sys/uio.h>
+
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/se_translating_port_proxy.hh"
@@ -168,6 +172,61 @@ class TypedBufferArg : public BaseBufferArg
     T &operator[](int i) { return ((T *)bufPtr)[i]; }
 };
 
+/**
+ * HostBufferArg represents a buffer in target user space that is read or
+ * written by a host system call, as a list of iovecs. The parts of the
+ * buffer in host memory the proxy can reach through a memory back door
+ * are handed to the system call in place, without being copied. The
+ * other parts are copied to and from a bounce buffer by copyIn() and
+ * copyOut().
+ */
+class HostBufferArg
+{
+  public:
+    /**
+     * @param _proxy Proxy to the target memory.
+     * @param addr Address of the buffer in target user space.
+     * @param size Size of the buffer.
+     * @param write Whether the system call writes to the buffer.
+     */
+    HostBufferArg(const TranslatingPortProxy &_proxy, Addr addr,
+                  uint64_t size, bool write);
+
+    /**
+     * Copy the parts of the buffer which are not accessed in place into
+     * the bounce buffer, before the system call reads them.
+     */
+    bool copyIn();
+
+    /**
+     * Copy the parts of the first size bytes of the buffer which are not
+     * accessed in place back to target memory, after the system call
+     * wrote them.
+     */
+    bool copyOut(uint64_t size);
+
+    /** The iovecs to hand to the system call. */
+    const std::vector<struct iovec> &iovecs() const { return iov; }
+
+  private:
+    /** Adds a chunk of the buffer, merging it with the last if possible. */
+    void addChunk(Addr addr, uint8_t *host, uint64_t size);
+
+    const TranslatingPortProxy &proxy;
+
+    std::vector<struct iovec> iov;
+
+    /** Target address of each iovec, and whether it is accessed in place. */
+    struct Chunk
+    {
+        Addr addr;
+        bool inPlace;
+    };
+    std::vector<Chunk> chunks;
+
+    std::unique_ptr<uint8_t[]> bounce;
+};
+
 } // namespace gem5
 
 #endif // __SIM_SYSCALL_EMUL_BUF_HH__
@@ -0,0 +1,91 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Memory test of a cache filling blocks and writing them back through a
+memory backdoor, while a tester without caches writes to the same blocks
+as a DMA device would. The cache is small, so that blocks are written
+back all the time, and the memory slow, so that the writes of the DMA
+tester are queued in front of it.
+"""
+
+import argparse
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath("../../../configs/")
+from common.Caches import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--mode", choices=["atomic", "timing"], default="timing")
+args = parser.parse_args()
+
+# MAX CORES IS 8 with the false sharing method, one of them for the DMA
+nb_cores = 4
+cpus = [MemTest(max_loads=1e5, progress_interval=1e4) for i in range(nb_cores)]
+dma = MemTest(
+    max_loads=1e5,
+    progress_interval=1e4,
+    percent_functional=0,
+    percent_uncacheable=0,
+)
+
+system = System(
+    cpu=cpus,
+    dma=dma,
+    physmem=SimpleMemory(latency="100ns"),
+    membus=SystemXBar(),
+)
+system.voltage_domain = VoltageDomain()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=system.voltage_domain
+)
+
+system.toL2Bus = L2XBar()
+system.l2c = L2Cache(size="4kB", assoc=2, mem_backdoor=True)
+system.l2c.cpu_side = system.toL2Bus.mem_side_ports
+system.l2c.mem_side = system.membus.cpu_side_ports
+
+for cpu in cpus:
+    cpu.l1c = L1Cache(size="1kB", assoc=2)
+    cpu.l1c.cpu_side = cpu.port
+    cpu.l1c.mem_side = system.toL2Bus.cpu_side_ports
+
+# The DMA tester accesses the memory through the membus, which snoops
+# the caches
+system.dma.port = system.membus.cpu_side_ports
+
+system.system_port = system.membus.cpu_side_ports
+system.physmem.port = system.membus.mem_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = args.mode
+
+m5.instantiate()
+exit_event = m5.simulate()
+if exit_event.getCause() != "maximum number of loads reached":
+    exit(1)
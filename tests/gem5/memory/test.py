@@ -70,6 +70,30 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+# A DMA tester writing to the blocks a cache writes back through a memory
+# backdoor
+for mode in ("atomic", "timing"):
+    gem5_verify_config(
+        name="memtest_backdoor_" + mode,
+        verifiers=(),
+        config=joinpath(getcwd(), "memtest-backdoor-run.py"),
+        config_args=["--mode", mode],
+        valid_isas=(constants.null_tag,),
+        length=constants.long_tag,
+    )
+
+# Timing packets crossing a ThreadBridge, with the memory on its own event
+# queue and on the same queue as the testers
+for threads in (False, True):
+    gem5_verify_config(
+        name="memtest_thread_bridge" + ("_threads" if threads else ""),
+        verifiers=(),
+        config=joinpath(getcwd(), "memtest-thread-bridge-run.py"),
+        config_args=["--mem-channel-threads"] if threads else [],
+        valid_isas=(constants.null_tag,),
+        length=constants.long_tag,
+    )
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
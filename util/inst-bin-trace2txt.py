@@ -0,0 +1,197 @@
+#! /usr/bin/env python3
+
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Prints the binary instruction trace written by the InstBinTrace
+# instruction tracer in a format close to the one of the Exec debug flags.
+#
+# The trace is a header followed by fixed size records, see
+# src/cpu/inst_bin_trace.hh. The static instructions are in a second
+# file, named after the trace with an .insts extension.
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b"gem5INST"
+VERSION = 1
+
+HEADER = struct.Struct("=8sIIQ")
+RECORD = struct.Struct("=QQQQQIIHHHBB")
+
+# Record flags
+MEM_VALID = 0x1
+PREDICATED_FALSE = 0x2
+FAULTING = 0x4
+MICROOP = 0x8
+SEQ_VALID = 0x20
+
+# InstRecord::DataStatus
+DATA_INVALID = 0
+DATA_DOUBLE = 3
+DATA_REG = 5
+
+# Number of records converted at a time
+CHUNK_RECORDS = 65536
+
+
+def open_file(name, mode):
+    if name.endswith(".gz"):
+        return gzip.open(name, mode)
+    return open(name, mode)
+
+
+def insts_file_name(trace_name):
+    if trace_name.endswith(".gz"):
+        return trace_name[: -len(".gz")] + ".insts.gz"
+    return trace_name + ".insts"
+
+
+def read_insts(f):
+    insts = {}
+    for line in f:
+        index, inst_bytes, op_class, dests, disasm = line.rstrip("\n").split(
+            "\t", 4
+        )
+        insts[int(index)] = (inst_bytes, op_class, dests, disasm)
+    return insts
+
+
+def format_data(status, data):
+    if status == DATA_INVALID:
+        return ""
+    if status == DATA_REG:
+        return " D=<not recorded>"
+    if status == DATA_DOUBLE:
+        return f" D={struct.unpack('=d', struct.pack('=Q', data))[0]}"
+    return f" D={data:#018x}"
+
+
+def convert(trace, insts, out, args):
+    magic, version, record_size, _ = HEADER.unpack(trace.read(HEADER.size))
+    if magic != MAGIC:
+        sys.exit("Not a binary instruction trace")
+    if version != VERSION or record_size != RECORD.size:
+        sys.exit(
+            f"Unsupported trace version {version} with {record_size} "
+            "byte records"
+        )
+
+    while True:
+        data = trace.read(CHUNK_RECORDS * RECORD.size)
+        if not data:
+            break
+        if len(data) % RECORD.size:
+            print("Warning: truncated trace", file=sys.stderr)
+            data = data[: len(data) - len(data) % RECORD.size]
+
+        lines = []
+        for (
+            tick,
+            pc,
+            seq_num,
+            mem_addr,
+            value,
+            inst,
+            mem_flags,
+            upc,
+            context_id,
+            mem_size,
+            data_status,
+            flags,
+        ) in RECORD.iter_unpack(data):
+            inst_bytes, op_class, dests, disasm = insts[inst]
+            upc_str = f".{upc:2d}" if flags & MICROOP else "   "
+            line = (
+                f"{tick:7d}: C{context_id} : {pc:#x}{upc_str} : "
+                f"{disasm:<26s} : "
+            )
+            if args.bytes:
+                line += f"{inst_bytes} : "
+            if args.op_class:
+                line += f"{op_class} : "
+            if flags & PREDICATED_FALSE:
+                line += "Predicated False"
+            line += format_data(data_status, value)
+            if flags & MEM_VALID:
+                line += f" A={mem_addr:#x}"
+                if args.mem:
+                    line += f" S={mem_size} F={mem_flags:#x}"
+            if args.seq and flags & SEQ_VALID:
+                line += f"  Seq={seq_num}"
+            if flags & FAULTING:
+                line += "  Faulting"
+            lines.append(line + "\n")
+        out.write("".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Print a binary instruction trace in a format close "
+        "to the one of the Exec debug flags."
+    )
+    parser.add_argument("tracefile", help="binary trace, may be gzipped")
+    parser.add_argument(
+        "-o",
+        dest="outfile",
+        default="-",
+        help="output file, standard output by default",
+    )
+    parser.add_argument(
+        "--insts",
+        help="instruction file, found from the trace file name by default",
+    )
+    parser.add_argument(
+        "--op-class", action="store_true", help="print the op classes"
+    )
+    parser.add_argument(
+        "--bytes", action="store_true", help="print the instruction bytes"
+    )
+    parser.add_argument(
+        "--mem",
+        action="store_true",
+        help="print the size and flags of the memory accesses",
+    )
+    parser.add_argument(
+        "--seq", action="store_true", help="print the sequence numbers"
+    )
+    args = parser.parse_args()
+
+    insts_name = args.insts or insts_file_name(args.tracefile)
+    with open_file(insts_name, "rt") as f:
+        insts = read_insts(f)
+
+    out = sys.stdout if args.outfile == "-" else open(args.outfile, "w")
+    with open_file(args.tracefile, "rb") as trace:
+        convert(trace, insts, out, args)
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,160 @@
+#! /usr/bin/env python3
+
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Converts the binary pipeline trace written by the O3 CPU when its
+# pipeTraceFile parameter is set to the text format printed by the
+# O3PipeView debug flag, which util/o3-pipeview.py reads.
+#
+# The trace is a header followed by fixed size records, see
+# src/cpu/o3/pipe_trace.hh. The disassembly of the instructions is in a
+# second file, named after the trace with a .disasm extension.
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b"gem5O3PT"
+VERSION = 1
+
+HEADER = struct.Struct("=8sII")
+RECORD = struct.Struct("=QQQIHH9iI")
+
+# Number of records converted at a time
+CHUNK_RECORDS = 65536
+
+
+def open_file(name, mode):
+    if name.endswith(".gz"):
+        return gzip.open(name, mode)
+    return open(name, mode)
+
+
+def disasm_file_name(trace_name):
+    if trace_name.endswith(".gz"):
+        return trace_name[: -len(".gz")] + ".disasm.gz"
+    return trace_name + ".disasm"
+
+
+def convert(trace, disasm, out, wib):
+    magic, version, record_size = HEADER.unpack(trace.read(HEADER.size))
+    if magic != MAGIC:
+        sys.exit("Not a binary O3 pipeline trace")
+    if version != VERSION or record_size != RECORD.size:
+        sys.exit(
+            f"Unsupported trace version {version} with {record_size} "
+            "byte records"
+        )
+
+    def tick(fetch, offset):
+        return 0 if offset == -1 else fetch + offset
+
+    while True:
+        data = trace.read(CHUNK_RECORDS * RECORD.size)
+        if not data:
+            break
+        if len(data) % RECORD.size:
+            print("Warning: truncated trace", file=sys.stderr)
+            data = data[: len(data) - len(data) % RECORD.size]
+
+        lines = []
+        for (
+            sn,
+            pc,
+            fetch,
+            disasm_idx,
+            upc,
+            tid,
+            decode,
+            rename,
+            dispatch,
+            issue,
+            complete,
+            commit,
+            store,
+            wib_enter,
+            wib_exit,
+            _,
+        ) in RECORD.iter_unpack(data):
+            lines.append(
+                f"O3PipeView:fetch:{fetch}:0x{pc:08x}:{upc}:{sn}:"
+                f"{disasm[disasm_idx]}\n"
+                f"O3PipeView:decode:{tick(fetch, decode)}\n"
+                f"O3PipeView:rename:{tick(fetch, rename)}\n"
+                f"O3PipeView:dispatch:{tick(fetch, dispatch)}\n"
+                f"O3PipeView:issue:{tick(fetch, issue)}\n"
+                f"O3PipeView:complete:{tick(fetch, complete)}\n"
+            )
+            if wib and wib_enter != -1:
+                lines.append(
+                    f"O3PipeView:wib:{tick(fetch, wib_enter)}:"
+                    f"{tick(fetch, wib_exit)}\n"
+                )
+            lines.append(
+                f"O3PipeView:retire:{tick(fetch, commit)}:"
+                f"store:{tick(fetch, store)}\n"
+            )
+        out.write("".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a binary O3 pipeline trace to the text "
+        "format of the O3PipeView debug flag."
+    )
+    parser.add_argument("tracefile", help="binary trace, may be gzipped")
+    parser.add_argument(
+        "-o",
+        dest="outfile",
+        default="-",
+        help="output file, standard output by default",
+    )
+    parser.add_argument(
+        "--disasm",
+        help="disassembly file, found from the trace file name by default",
+    )
+    parser.add_argument(
+        "--wib",
+        action="store_true",
+        help="also print when instructions enter and leave the WIB",
+    )
+    args = parser.parse_args()
+
+    disasm_name = args.disasm or disasm_file_name(args.tracefile)
+    with open_file(disasm_name, "rt") as f:
+        disasm = f.read().split("\n")
+
+    out = sys.stdout if args.outfile == "-" else open(args.outfile, "w")
+    with open_file(args.tracefile, "rb") as trace:
+        convert(trace, disasm, out, args.wib)
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()